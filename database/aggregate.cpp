@@ -0,0 +1,77 @@
+#include "aggregate.hpp"
+#include <charconv>
+#include <limits>
+
+void printReal(std::ostream& out, double value)
+{
+  char buffer[32];
+  auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.write(buffer, result.ptr - buffer);
+}
+
+void printNumber(std::ostream& out, babinov::DataType dataType, long long integer, double real)
+{
+  if (dataType == babinov::REAL)
+  {
+    printReal(out, real);
+  }
+  else
+  {
+    out << integer;
+  }
+}
+
+namespace babinov
+{
+  Accumulator::Accumulator() noexcept:
+    count(0),
+    integerSum(0),
+    integerMin(std::numeric_limits< long long >::max()),
+    integerMax(std::numeric_limits< long long >::min()),
+    realSum(0.0),
+    realMin(std::numeric_limits< double >::infinity()),
+    realMax(-std::numeric_limits< double >::infinity())
+  {}
+
+  void Accumulator::merge(const Accumulator& other) noexcept
+  {
+    count += other.count;
+    integerSum += other.integerSum;
+    integerMin = minValue(integerMin, other.integerMin);
+    integerMax = maxValue(integerMax, other.integerMax);
+    realSum += other.realSum;
+    realMin = minValue(realMin, other.realMin);
+    realMax = maxValue(realMax, other.realMax);
+  }
+
+  void printAggregate(std::ostream& out, AggregateFunction function, DataType dataType, const Accumulator& accumulator)
+  {
+    if (function == COUNT)
+    {
+      out << accumulator.count;
+      return;
+    }
+    if ((function != SUM) && !accumulator.count)
+    {
+      out << "NULL";
+      return;
+    }
+    if (function == SUM)
+    {
+      printNumber(out, dataType, accumulator.integerSum, accumulator.realSum);
+    }
+    else if (function == MIN)
+    {
+      printNumber(out, dataType, accumulator.integerMin, accumulator.realMin);
+    }
+    else if (function == MAX)
+    {
+      printNumber(out, dataType, accumulator.integerMax, accumulator.realMax);
+    }
+    else
+    {
+      double sum = (dataType == REAL) ? accumulator.realSum : static_cast< double >(accumulator.integerSum);
+      printReal(out, sum / accumulator.count);
+    }
+  }
+}
@@ -0,0 +1,63 @@
+#ifndef AGGREGATE_HPP
+#define AGGREGATE_HPP
+#include <ostream>
+#include <string>
+
+#include "data_types.hpp"
+#include "hash_table.hpp"
+
+namespace babinov
+{
+  enum AggregateFunction
+  {
+    COUNT,
+    SUM,
+    MIN,
+    MAX,
+    AVG
+  };
+
+  const HashTable< std::string, AggregateFunction > AGGREGATE_FUNCTIONS_FROM_STR = {
+    {"count", COUNT},
+    {"sum", SUM},
+    {"min", MIN},
+    {"max", MAX},
+    {"avg", AVG}
+  };
+
+  struct Aggregate
+  {
+    AggregateFunction function;
+    size_t columnIndex;
+  };
+
+  struct Accumulator
+  {
+    size_t count;
+    long long integerSum;
+    long long integerMin;
+    long long integerMax;
+    double realSum;
+    double realMin;
+    double realMax;
+
+    Accumulator() noexcept;
+    void merge(const Accumulator& other) noexcept;
+  };
+
+  template< class T >
+  T minValue(T lhs, T rhs) noexcept
+  {
+    return ((rhs < lhs) || (rhs != rhs)) ? rhs : lhs;
+  }
+
+  template< class T >
+  T maxValue(T lhs, T rhs) noexcept
+  {
+    return ((lhs < rhs) || (rhs != rhs)) ? rhs : lhs;
+  }
+
+  void printAggregate(std::ostream& out, AggregateFunction function, DataType dataType, const Accumulator& accumulator);
+}
+
+#endif
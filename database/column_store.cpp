@@ -0,0 +1,793 @@
+#include "column_store.hpp"
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include "scan_kernels.hpp"
+#include "value_parser.hpp"
+
+double toReal(const std::string& value)
+{
+  double real = 0.0;
+  if (babinov::parseReal(value, real) != babinov::PARSE_OK)
+  {
+    throw std::invalid_argument("Invalid value");
+  }
+  return real;
+}
+
+long long toInteger(const std::string& value, babinov::DataType dataType)
+{
+  long long integer = 0;
+  if (babinov::parseInteger(value, dataType, integer) != babinov::PARSE_OK)
+  {
+    throw std::invalid_argument("Invalid value");
+  }
+  return integer;
+}
+
+template< class Getter, class Predicate >
+void collectSlots(const babinov::Vector< bool >& isAlive, size_t begin, size_t end, Getter get, Predicate pred,
+  babinov::Vector< size_t >& slots)
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    if (isAlive[i] && pred(get(i)))
+    {
+      slots.pushBack(i);
+    }
+  }
+}
+
+template< class T, class Getter >
+void filterValues(const babinov::Condition& condition, T lower, T upper, Getter get,
+  const babinov::Vector< bool >& isAlive, size_t begin, size_t end, babinov::Vector< size_t >& slots)
+{
+  switch (condition.getOperation())
+  {
+  case babinov::EQUAL:
+    collectSlots(isAlive, begin, end, get, [&](T value) { return value == lower; }, slots);
+    break;
+  case babinov::LESS:
+    collectSlots(isAlive, begin, end, get, [&](T value) { return value < lower; }, slots);
+    break;
+  case babinov::LESS_EQUAL:
+    collectSlots(isAlive, begin, end, get, [&](T value) { return value <= lower; }, slots);
+    break;
+  case babinov::GREATER:
+    collectSlots(isAlive, begin, end, get, [&](T value) { return value > lower; }, slots);
+    break;
+  case babinov::GREATER_EQUAL:
+    collectSlots(isAlive, begin, end, get, [&](T value) { return value >= lower; }, slots);
+    break;
+  case babinov::BETWEEN:
+    collectSlots(isAlive, begin, end, get, [&](T value) { return (lower <= value) && (value <= upper); }, slots);
+    break;
+  }
+}
+
+template< class T >
+void collectAlive(const babinov::Vector< T >& values, const babinov::Vector< bool >& isAlive, babinov::Vector< T >& dest)
+{
+  dest.reserve(values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+  {
+    if (isAlive[i])
+    {
+      dest.pushBack(values[i]);
+    }
+  }
+}
+
+template< class T >
+void readValues(const char* payload, size_t nValues, babinov::Vector< T >& dest)
+{
+  dest.reserve(nValues);
+  for (size_t i = 0; i < nValues; ++i)
+  {
+    T value;
+    std::memcpy(&value, payload + i * sizeof(T), sizeof(T));
+    dest.pushBack(value);
+  }
+}
+
+template< class T >
+void accumulateValues(const T* values, const babinov::Vector< size_t >& slots, T& sum, T& min, T& max)
+{
+  T localSum = sum;
+  T localMin = min;
+  T localMax = max;
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    T value = values[slots[i]];
+    localSum += value;
+    localMin = babinov::minValue(localMin, value);
+    localMax = babinov::maxValue(localMax, value);
+  }
+  sum = localSum;
+  min = localMin;
+  max = localMax;
+}
+
+template< class T >
+void accumulateGroups(const T* values, const babinov::Vector< size_t >& slots, const babinov::Vector< size_t >& groups,
+  babinov::Vector< babinov::Accumulator >& accumulators, T babinov::Accumulator::* sum, T babinov::Accumulator::* min,
+  T babinov::Accumulator::* max)
+{
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    babinov::Accumulator& accumulator = accumulators[groups[i]];
+    T value = values[slots[i]];
+    ++accumulator.count;
+    accumulator.*sum += value;
+    accumulator.*min = babinov::minValue(accumulator.*min, value);
+    accumulator.*max = babinov::maxValue(accumulator.*max, value);
+  }
+}
+
+namespace babinov
+{
+  ColumnStore::ColumnStore(DataType dataType):
+    dataType_(dataType),
+    integers_(),
+    reals_(),
+    texts_(),
+    blob_(),
+    garbage_(0),
+    isEncoded_(false),
+    codes_(),
+    dictionary_(),
+    dictionaryCodes_(),
+    codeUses_(),
+    nUnusedCodes_(0)
+  {}
+
+  ColumnStore::ColumnStore(ColumnStore&& other) noexcept:
+    dataType_(other.dataType_),
+    integers_(std::move(other.integers_)),
+    reals_(std::move(other.reals_)),
+    texts_(std::move(other.texts_)),
+    blob_(std::move(other.blob_)),
+    garbage_(other.garbage_),
+    isEncoded_(other.isEncoded_),
+    codes_(std::move(other.codes_)),
+    dictionary_(std::move(other.dictionary_)),
+    dictionaryCodes_(std::move(other.dictionaryCodes_)),
+    codeUses_(std::move(other.codeUses_)),
+    nUnusedCodes_(other.nUnusedCodes_)
+  {
+    other.garbage_ = 0;
+    other.isEncoded_ = false;
+    other.nUnusedCodes_ = 0;
+  }
+
+  ColumnStore& ColumnStore::operator=(const ColumnStore& other)
+  {
+    if (this != &other)
+    {
+      ColumnStore temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  ColumnStore& ColumnStore::operator=(ColumnStore&& other) noexcept
+  {
+    if (this != &other)
+    {
+      ColumnStore temp(std::move(other));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  DataType ColumnStore::getDataType() const noexcept
+  {
+    return dataType_;
+  }
+
+  size_t ColumnStore::size() const noexcept
+  {
+    if (dataType_ == REAL)
+    {
+      return reals_.size();
+    }
+    else if (dataType_ == TEXT)
+    {
+      return isEncoded_ ? codes_.size() : texts_.size();
+    }
+    return integers_.size();
+  }
+
+  bool ColumnStore::isEncoded() const noexcept
+  {
+    return isEncoded_;
+  }
+
+  long long ColumnStore::getInteger(size_t pos) const
+  {
+    return integers_[pos];
+  }
+
+  double ColumnStore::getReal(size_t pos) const
+  {
+    return reals_[pos];
+  }
+
+  std::string_view ColumnStore::getText(size_t pos) const
+  {
+    const TextRef& ref = isEncoded_ ? dictionary_[codes_[pos]] : texts_[pos];
+    return std::string_view(blob_.data() + ref.offset, ref.length);
+  }
+
+  std::string ColumnStore::getAsString(size_t pos) const
+  {
+    if (dataType_ == TEXT)
+    {
+      return std::string(getText(pos));
+    }
+    else if (dataType_ == REAL)
+    {
+      char buffer[32];
+      auto result = std::to_chars(buffer, buffer + sizeof(buffer), reals_[pos]);
+      return std::string(buffer, result.ptr);
+    }
+    return std::to_string(integers_[pos]);
+  }
+
+  bool ColumnStore::isMatch(size_t pos, const Condition& condition) const noexcept
+  {
+    if (dataType_ == TEXT)
+    {
+      return condition.isMatch(getText(pos));
+    }
+    else if (dataType_ == REAL)
+    {
+      return condition.isMatch(reals_[pos]);
+    }
+    return condition.isMatch(integers_[pos]);
+  }
+
+  void ColumnStore::filter(const Condition& condition, const Vector< bool >& isAlive, size_t begin, size_t end,
+    Vector< size_t >& slots) const
+  {
+    if (dataType_ == TEXT)
+    {
+      uint32_t code = 0;
+      if (isEncoded_ && (condition.getOperation() == EQUAL))
+      {
+        auto get = [this](size_t i)
+        {
+          return codes_[i];
+        };
+        if (findCode(condition.getText(), code))
+        {
+          filterValues(condition, code, code, get, isAlive, begin, end, slots);
+        }
+        return;
+      }
+      auto get = [this](size_t i)
+      {
+        return getText(i);
+      };
+      std::string_view lower(condition.getText());
+      std::string_view upper(condition.getUpperText());
+      filterValues(condition, lower, upper, get, isAlive, begin, end, slots);
+    }
+    else if (dataType_ == REAL)
+    {
+      double lower = 0.0;
+      double upper = 0.0;
+      if (makeRange(condition, lower, upper))
+      {
+        selectSlots(reals_.data(), isAlive.data(), begin, end, lower, upper, slots);
+      }
+    }
+    else
+    {
+      long long lower = 0;
+      long long upper = 0;
+      if (makeRange(condition, lower, upper))
+      {
+        selectSlots(integers_.data(), isAlive.data(), begin, end, lower, upper, slots);
+      }
+    }
+  }
+
+  size_t ColumnStore::count(const Condition& condition, const Vector< bool >& isAlive, size_t begin, size_t end) const
+  {
+    if (dataType_ == TEXT)
+    {
+      size_t count = 0;
+      uint32_t code = 0;
+      if (isEncoded_ && (condition.getOperation() == EQUAL))
+      {
+        if (!findCode(condition.getText(), code))
+        {
+          return 0;
+        }
+        for (size_t i = begin; i < end; ++i)
+        {
+          count += isAlive[i] && (codes_[i] == code);
+        }
+        return count;
+      }
+      for (size_t i = begin; i < end; ++i)
+      {
+        count += isAlive[i] && condition.isMatch(getText(i));
+      }
+      return count;
+    }
+    else if (dataType_ == REAL)
+    {
+      double lower = 0.0;
+      double upper = 0.0;
+      return makeRange(condition, lower, upper) ? countSlots(reals_.data(), isAlive.data(), begin, end, lower, upper) : 0;
+    }
+    long long lower = 0;
+    long long upper = 0;
+    return makeRange(condition, lower, upper) ? countSlots(integers_.data(), isAlive.data(), begin, end, lower, upper) : 0;
+  }
+
+  void ColumnStore::accumulate(const Vector< size_t >& slots, Accumulator& accumulator) const
+  {
+    if (dataType_ == TEXT)
+    {
+      throw std::logic_error("Cannot aggregate text column");
+    }
+    else if (dataType_ == REAL)
+    {
+      accumulateValues(reals_.data(), slots, accumulator.realSum, accumulator.realMin, accumulator.realMax);
+    }
+    else
+    {
+      accumulateValues(integers_.data(), slots, accumulator.integerSum, accumulator.integerMin, accumulator.integerMax);
+    }
+    accumulator.count += slots.size();
+  }
+
+  void ColumnStore::accumulate(const Vector< size_t >& slots, const Vector< size_t >& groups,
+    Vector< Accumulator >& accumulators) const
+  {
+    if (dataType_ == TEXT)
+    {
+      throw std::logic_error("Cannot aggregate text column");
+    }
+    else if (dataType_ == REAL)
+    {
+      using A = Accumulator;
+      accumulateGroups(reals_.data(), slots, groups, accumulators, &A::realSum, &A::realMin, &A::realMax);
+    }
+    else
+    {
+      using A = Accumulator;
+      accumulateGroups(integers_.data(), slots, groups, accumulators, &A::integerSum, &A::integerMin, &A::integerMax);
+    }
+  }
+
+  void ColumnStore::print(std::ostream& out, size_t pos) const
+  {
+    if (dataType_ == TEXT)
+    {
+      out << '\"' << getText(pos) << '\"';
+    }
+    else if (dataType_ == REAL)
+    {
+      out << getAsString(pos);
+    }
+    else
+    {
+      out << integers_[pos];
+    }
+  }
+
+  void ColumnStore::prefetch(size_t pos) const noexcept
+  {
+    if (dataType_ == TEXT)
+    {
+      if (isEncoded_)
+      {
+        __builtin_prefetch(codes_.data() + pos);
+      }
+      else
+      {
+        __builtin_prefetch(blob_.data() + texts_[pos].offset);
+      }
+    }
+    else if (dataType_ == REAL)
+    {
+      __builtin_prefetch(reals_.data() + pos);
+    }
+    else
+    {
+      __builtin_prefetch(integers_.data() + pos);
+    }
+  }
+
+  void ColumnStore::writeSnapshot(std::ostream& out, const Vector< bool >& isAlive) const
+  {
+    if (dataType_ == TEXT)
+    {
+      Vector< uint64_t > lengths;
+      std::string blob;
+      blob.reserve(blob_.size() - garbage_);
+      for (size_t i = 0; i < size(); ++i)
+      {
+        if (isAlive[i])
+        {
+          std::string_view text = getText(i);
+          lengths.pushBack(text.size());
+          blob.append(text);
+        }
+      }
+      std::string payload(reinterpret_cast< const char* >(lengths.data()), lengths.size() * sizeof(uint64_t));
+      payload.append(blob);
+      writeBlock(out, payload.data(), payload.size());
+    }
+    else if (dataType_ == REAL)
+    {
+      Vector< double > values;
+      collectAlive(reals_, isAlive, values);
+      writeBlock(out, reinterpret_cast< const char* >(values.data()), values.size() * sizeof(double));
+    }
+    else
+    {
+      Vector< long long > values;
+      collectAlive(integers_, isAlive, values);
+      writeBlock(out, reinterpret_cast< const char* >(values.data()), values.size() * sizeof(long long));
+    }
+  }
+
+  bool ColumnStore::readSnapshot(SnapshotReader& reader, size_t nRows)
+  {
+    const char* payload = nullptr;
+    size_t size = 0;
+    if ((!reader.readBlock(payload, size)) || (nRows > size / sizeof(uint64_t)))
+    {
+      return false;
+    }
+    clear();
+    if (dataType_ == TEXT)
+    {
+      size_t blobSize = size - nRows * sizeof(uint64_t);
+      blob_.assign(payload + nRows * sizeof(uint64_t), blobSize);
+      texts_.reserve(nRows);
+      size_t offset = 0;
+      for (size_t i = 0; i < nRows; ++i)
+      {
+        uint64_t length = 0;
+        std::memcpy(&length, payload + i * sizeof(uint64_t), sizeof(uint64_t));
+        if (length > blobSize - offset)
+        {
+          return false;
+        }
+        texts_.pushBack({ offset, static_cast< size_t >(length) });
+        offset += length;
+      }
+      return offset == blobSize;
+    }
+    if (size != nRows * sizeof(uint64_t))
+    {
+      return false;
+    }
+    if (dataType_ == REAL)
+    {
+      readValues(payload, nRows, reals_);
+    }
+    else
+    {
+      readValues(payload, nRows, integers_);
+    }
+    return true;
+  }
+
+  void ColumnStore::pushBack(const std::string& value)
+  {
+    if (dataType_ == TEXT)
+    {
+      pushText(value);
+    }
+    else if (dataType_ == REAL)
+    {
+      reals_.pushBack(toReal(value));
+    }
+    else
+    {
+      integers_.pushBack(toInteger(value, dataType_));
+    }
+  }
+
+  void ColumnStore::pushInteger(long long value)
+  {
+    integers_.pushBack(value);
+  }
+
+  void ColumnStore::pushReal(double value)
+  {
+    reals_.pushBack(value);
+  }
+
+  void ColumnStore::pushText(std::string_view value)
+  {
+    if (isEncoded_)
+    {
+      codes_.pushBack(getCode(std::string(value)));
+      checkDictionary();
+      return;
+    }
+    texts_.pushBack(appendText(value));
+  }
+
+  void ColumnStore::append(ColumnStore&& other)
+  {
+    if (!size())
+    {
+      ColumnStore temp(std::move(other));
+      swap(temp);
+      return;
+    }
+    if (dataType_ == TEXT)
+    {
+      if (!isEncoded_)
+      {
+        texts_.reserve(texts_.size() + other.size());
+        blob_.reserve(blob_.size() + other.blob_.size() - other.garbage_);
+      }
+      for (size_t i = 0; i < other.size(); ++i)
+      {
+        pushText(other.getText(i));
+      }
+    }
+    else if (dataType_ == REAL)
+    {
+      reals_.reserve(reals_.size() + other.reals_.size());
+      for (size_t i = 0; i < other.reals_.size(); ++i)
+      {
+        reals_.pushBack(other.reals_[i]);
+      }
+    }
+    else
+    {
+      integers_.reserve(integers_.size() + other.integers_.size());
+      for (size_t i = 0; i < other.integers_.size(); ++i)
+      {
+        integers_.pushBack(other.integers_[i]);
+      }
+    }
+  }
+
+  void ColumnStore::set(size_t pos, const std::string& value)
+  {
+    if (isEncoded_)
+    {
+      uint32_t code = getCode(value);
+      releaseCode(codes_[pos]);
+      codes_[pos] = code;
+      checkDictionary();
+    }
+    else if (dataType_ == TEXT)
+    {
+      garbage_ += texts_[pos].length;
+      texts_[pos] = appendText(value);
+      if (garbage_ > (blob_.size() / 2))
+      {
+        collectGarbage();
+      }
+    }
+    else if (dataType_ == REAL)
+    {
+      reals_[pos] = toReal(value);
+    }
+    else
+    {
+      integers_[pos] = toInteger(value, dataType_);
+    }
+  }
+
+  void ColumnStore::compact(const Vector< bool >& isAlive)
+  {
+    if (isEncoded_)
+    {
+      Vector< uint32_t > codes;
+      codes.reserve(codes_.size());
+      for (size_t i = 0; i < codes_.size(); ++i)
+      {
+        if (isAlive[i])
+        {
+          codes.pushBack(codes_[i]);
+        }
+        else
+        {
+          releaseCode(codes_[i]);
+        }
+      }
+      codes_.swap(codes);
+      checkDictionary();
+      return;
+    }
+    ColumnStore result(dataType_);
+    for (size_t i = 0; i < isAlive.size(); ++i)
+    {
+      if (!isAlive[i])
+      {
+        continue;
+      }
+      if (dataType_ == TEXT)
+      {
+        result.pushText(getText(i));
+      }
+      else if (dataType_ == REAL)
+      {
+        result.reals_.pushBack(reals_[i]);
+      }
+      else
+      {
+        result.integers_.pushBack(integers_[i]);
+      }
+    }
+    swap(result);
+  }
+
+  bool ColumnStore::encode()
+  {
+    if ((dataType_ != TEXT) || isEncoded_ || (size() < MIN_ENCODED_SIZE_))
+    {
+      return isEncoded_;
+    }
+    ColumnStore result(dataType_);
+    result.isEncoded_ = true;
+    result.codes_.reserve(size());
+    std::string value;
+    for (size_t i = 0; i < size(); ++i)
+    {
+      value.assign(getText(i));
+      result.codes_.pushBack(result.getCode(value));
+      if (result.dictionary_.size() * ENCODING_RATIO_ > size())
+      {
+        return false;
+      }
+    }
+    swap(result);
+    return true;
+  }
+
+  void ColumnStore::swap(ColumnStore& other) noexcept
+  {
+    std::swap(dataType_, other.dataType_);
+    integers_.swap(other.integers_);
+    reals_.swap(other.reals_);
+    texts_.swap(other.texts_);
+    blob_.swap(other.blob_);
+    std::swap(garbage_, other.garbage_);
+    std::swap(isEncoded_, other.isEncoded_);
+    codes_.swap(other.codes_);
+    dictionary_.swap(other.dictionary_);
+    dictionaryCodes_.swap(other.dictionaryCodes_);
+    codeUses_.swap(other.codeUses_);
+    std::swap(nUnusedCodes_, other.nUnusedCodes_);
+  }
+
+  void ColumnStore::clear() noexcept
+  {
+    integers_.clear();
+    reals_.clear();
+    texts_.clear();
+    blob_.clear();
+    garbage_ = 0;
+    isEncoded_ = false;
+    codes_.clear();
+    dictionary_.clear();
+    dictionaryCodes_.clear();
+    codeUses_.clear();
+    nUnusedCodes_ = 0;
+  }
+
+  ColumnStore::TextRef ColumnStore::appendText(std::string_view value)
+  {
+    TextRef ref{blob_.size(), value.size()};
+    blob_.append(value);
+    return ref;
+  }
+
+  void ColumnStore::collectGarbage()
+  {
+    std::string blob;
+    blob.reserve(blob_.size() - garbage_);
+    for (size_t i = 0; i < texts_.size(); ++i)
+    {
+      TextRef& ref = texts_[i];
+      size_t offset = blob.size();
+      blob.append(blob_, ref.offset, ref.length);
+      ref.offset = offset;
+    }
+    blob_.swap(blob);
+    garbage_ = 0;
+  }
+  uint32_t ColumnStore::getCode(const std::string& value)
+  {
+    auto inserted = dictionaryCodes_.insert(value, static_cast< uint32_t >(dictionary_.size()));
+    uint32_t code = (*inserted.first).second;
+    if (inserted.second)
+    {
+      dictionary_.pushBack(appendText(value));
+      codeUses_.pushBack(0);
+    }
+    else if (!codeUses_[code])
+    {
+      --nUnusedCodes_;
+    }
+    ++codeUses_[code];
+    return code;
+  }
+
+  bool ColumnStore::findCode(std::string_view value, uint32_t& code) const
+  {
+    const uint32_t* desired = dictionaryCodes_.findEquivalent(value);
+    if (!desired)
+    {
+      return false;
+    }
+    code = *desired;
+    return true;
+  }
+
+  void ColumnStore::releaseCode(uint32_t code) noexcept
+  {
+    if (!--codeUses_[code])
+    {
+      ++nUnusedCodes_;
+    }
+  }
+
+  void ColumnStore::checkDictionary()
+  {
+    size_t limit = codes_.size() + MIN_ENCODED_SIZE_ * ENCODING_RATIO_;
+    if ((dictionary_.size() - nUnusedCodes_) * ENCODING_RATIO_ > limit)
+    {
+      decode();
+    }
+    else if (nUnusedCodes_ * ENCODING_RATIO_ > limit)
+    {
+      collectDictionary();
+    }
+  }
+
+  void ColumnStore::collectDictionary()
+  {
+    ColumnStore result(dataType_);
+    result.isEncoded_ = true;
+    Vector< uint32_t > newCodes;
+    newCodes.reserve(dictionary_.size());
+    std::string value;
+    for (size_t i = 0; i < dictionary_.size(); ++i)
+    {
+      newCodes.pushBack(static_cast< uint32_t >(result.dictionary_.size()));
+      if (codeUses_[i])
+      {
+        value.assign(blob_, dictionary_[i].offset, dictionary_[i].length);
+        result.codeUses_[result.getCode(value)] = codeUses_[i];
+      }
+    }
+    result.codes_.reserve(codes_.size());
+    for (size_t i = 0; i < codes_.size(); ++i)
+    {
+      result.codes_.pushBack(newCodes[codes_[i]]);
+    }
+    swap(result);
+  }
+
+  void ColumnStore::decode()
+  {
+    ColumnStore result(dataType_);
+    result.texts_.reserve(codes_.size());
+    for (size_t i = 0; i < codes_.size(); ++i)
+    {
+      result.texts_.pushBack(result.appendText(getText(i)));
+    }
+    swap(result);
+  }
+}
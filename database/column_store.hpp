@@ -0,0 +1,92 @@
+#ifndef COLUMN_STORE_HPP
+#define COLUMN_STORE_HPP
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "aggregate.hpp"
+#include "condition.hpp"
+#include "data_types.hpp"
+#include "hash_policies.hpp"
+#include "snapshot.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  class ColumnStore
+  {
+  public:
+    explicit ColumnStore(DataType dataType = PK);
+    ColumnStore(const ColumnStore& other) = default;
+    ColumnStore(ColumnStore&& other) noexcept;
+    ~ColumnStore() = default;
+    ColumnStore& operator=(const ColumnStore& other);
+    ColumnStore& operator=(ColumnStore&& other) noexcept;
+
+    DataType getDataType() const noexcept;
+    size_t size() const noexcept;
+    bool isEncoded() const noexcept;
+
+    long long getInteger(size_t pos) const;
+    double getReal(size_t pos) const;
+    std::string_view getText(size_t pos) const;
+    std::string getAsString(size_t pos) const;
+    bool isMatch(size_t pos, const Condition& condition) const noexcept;
+    void filter(const Condition& condition, const Vector< bool >& isAlive, size_t begin, size_t end,
+      Vector< size_t >& slots) const;
+    size_t count(const Condition& condition, const Vector< bool >& isAlive, size_t begin, size_t end) const;
+    void accumulate(const Vector< size_t >& slots, Accumulator& accumulator) const;
+    void accumulate(const Vector< size_t >& slots, const Vector< size_t >& groups,
+      Vector< Accumulator >& accumulators) const;
+    void print(std::ostream& out, size_t pos) const;
+    void prefetch(size_t pos) const noexcept;
+    void writeSnapshot(std::ostream& out, const Vector< bool >& isAlive) const;
+    bool readSnapshot(SnapshotReader& reader, size_t nRows);
+
+    void pushBack(const std::string& value);
+    void pushInteger(long long value);
+    void pushReal(double value);
+    void pushText(std::string_view value);
+    void append(ColumnStore&& other);
+    void set(size_t pos, const std::string& value);
+    void compact(const Vector< bool >& isAlive);
+    bool encode();
+    void swap(ColumnStore& other) noexcept;
+    void clear() noexcept;
+
+  private:
+    struct TextRef
+    {
+      size_t offset;
+      size_t length;
+    };
+
+    static const size_t MIN_ENCODED_SIZE_ = 64;
+    static const size_t ENCODING_RATIO_ = 4;
+
+    DataType dataType_;
+    Vector< long long > integers_;
+    Vector< double > reals_;
+    Vector< TextRef > texts_;
+    std::string blob_;
+    size_t garbage_;
+    bool isEncoded_;
+    Vector< uint32_t > codes_;
+    Vector< TextRef > dictionary_;
+    HashMap< std::string, uint32_t > dictionaryCodes_;
+    Vector< size_t > codeUses_;
+    size_t nUnusedCodes_;
+
+    TextRef appendText(std::string_view value);
+    void collectGarbage();
+    uint32_t getCode(const std::string& value);
+    bool findCode(std::string_view value, uint32_t& code) const;
+    void releaseCode(uint32_t code) noexcept;
+    void checkDictionary();
+    void collectDictionary();
+    void decode();
+  };
+}
+
+#endif
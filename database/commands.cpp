@@ -1,17 +1,30 @@
-#include <fstream>
+#include <algorithm>
+#include <cctype>
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <sstream>
 #include <stdexcept>
 
-#include "hash_table.hpp"
+#include "aggregate.hpp"
+#include "external_sort.hpp"
+#include "hash_join.hpp"
+#include "hash_policies.hpp"
 #include "delimiters.hpp"
+#include "prepared_statement.hpp"
+#include "query_profile.hpp"
 #include "tables.hpp"
+#include "table_loader.hpp"
+#include "thread_pool.hpp"
+#include "value_parser.hpp"
+#include "write_ahead_log.hpp"
 
 babinov::DataType getColumnType(const babinov::Table& table, const std::string& columnName)
 {
   return table.getColumns()[table.getColumnIndex(columnName)].second;
 }
 
-void readTableName(std::istream& in, const babinov::HashTable< std::string, babinov::Table >& tables, std::string& dest)
+void readTableName(std::istream& in, const babinov::HashMap< std::string, babinov::Table >& tables, std::string& dest)
 {
   in >> dest;
   if (tables.find(dest) == tables.cend())
@@ -33,31 +46,891 @@ void readValue(std::istream& in, std::string& value, babinov::DataType dataType)
   }
   else
   {
-    in >> value;
+    value.clear();
+    in >> std::ws;
+    while (in && !std::isspace(in.peek()) && (in.peek() != ')') && (in.peek() != EOF))
+    {
+      value += in.get();
+    }
+    if (value.empty())
+    {
+      in.setstate(std::ios::failbit);
+    }
+  }
+  if (!in)
+  {
+    throw std::invalid_argument("<ERROR: INVALID VALUE>");
+  }
+}
+
+void skipBlanks(std::istream& in)
+{
+  while ((in.peek() == ' ') || (in.peek() == '\t'))
+  {
+    in.get();
+  }
+}
+
+babinov::CompareOperation readOperation(std::istream& in)
+{
+  skipBlanks(in);
+  char c = in.get();
+  if (c == '=')
+  {
+    return babinov::EQUAL;
+  }
+  else if ((c == '<') || (c == '>'))
+  {
+    bool isInclusive = in.peek() == '=';
+    if (isInclusive)
+    {
+      in.get();
+    }
+    if (c == '<')
+    {
+      return isInclusive ? babinov::LESS_EQUAL : babinov::LESS;
+    }
+    return isInclusive ? babinov::GREATER_EQUAL : babinov::GREATER;
+  }
+  in.unget();
+  using del = babinov::StringDelimiterI;
+  in >> del::insensitive("between");
+  if (!in)
+  {
+    throw std::invalid_argument("<ERROR: INVALID CONDITION>");
+  }
+  return babinov::BETWEEN;
+}
+
+babinov::WriteAheadLog* findLog(babinov::LogMap& logs, const std::string& tableName)
+{
+  auto it = logs.find(tableName);
+  return (it != logs.end()) ? (*it).second.get() : nullptr;
+}
+
+template< class Writer >
+void writeLog(babinov::WriteAheadLog* log, Writer write)
+{
+  if (!log)
+  {
+    return;
+  }
+  try
+  {
+    write(*log);
+  }
+  catch (const std::runtime_error&)
+  {
+    throw std::invalid_argument("<ERROR: CANNOT WRITE LOG>");
+  }
+}
+
+void readColumnName(std::istream& in, std::string& columnName)
+{
+  skipBlanks(in);
+  while (in && ((std::isalnum(in.peek())) || (in.peek() == '_')))
+  {
+    columnName += in.get();
+  }
+}
+
+void readArgument(std::istream& in, std::string& value, babinov::DataType dataType,
+  babinov::Vector< babinov::DataType >* parameters, size_t& parameter)
+{
+  skipBlanks(in);
+  if (!parameters || (in.peek() != '?'))
+  {
+    readValue(in, value, dataType);
+    return;
+  }
+  in.get();
+  parameter = parameters->size();
+  parameters->pushBack(dataType);
+  value = (dataType == babinov::TEXT) ? std::string() : std::string("0");
+}
+
+void readConditionBody(std::istream& in, const babinov::Table& table, const std::string& columnName,
+  babinov::Condition& condition, babinov::Vector< babinov::DataType >* parameters)
+{
+  babinov::DataType dataType = babinov::PK;
+  try
+  {
+    dataType = getColumnType(table, columnName);
+  }
+  catch (const std::out_of_range&)
+  {
+    throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+  }
+  babinov::CompareOperation operation = readOperation(in);
+  std::string value;
+  std::string upperValue;
+  size_t parameter = babinov::NO_PARAMETER;
+  size_t upperParameter = babinov::NO_PARAMETER;
+  readArgument(in, value, dataType, parameters, parameter);
+  if (operation == babinov::BETWEEN)
+  {
+    using del = babinov::StringDelimiterI;
+    in >> del::insensitive("and");
+    if (!in)
+    {
+      throw std::invalid_argument("<ERROR: INVALID CONDITION>");
+    }
+    readArgument(in, upperValue, dataType, parameters, upperParameter);
+  }
+  try
+  {
+    condition = table.makeCondition(columnName, operation, value, upperValue);
+    condition.setParameters(parameter, upperParameter);
+  }
+  catch (const std::exception&)
+  {
+    throw std::invalid_argument("<ERROR: INVALID VALUE>");
+  }
+}
+
+std::string toLower(std::string word)
+{
+  std::transform(word.begin(), word.end(), word.begin(), ::tolower);
+  return word;
+}
+
+bool isLineEnd(std::istream& in)
+{
+  skipBlanks(in);
+  return !in || (in.peek() == '\n') || (in.peek() == EOF);
+}
+
+bool isKeyword(std::istream& in, const std::string& word, const char* keyword)
+{
+  skipBlanks(in);
+  char next = in.peek();
+  return (toLower(word) == keyword) && (next != '=') && (next != '<') && (next != '>');
+}
+
+bool isSelectClause(std::istream& in, const std::string& word)
+{
+  return isKeyword(in, word, "order") || isKeyword(in, word, "limit") || isKeyword(in, word, "offset")
+    || isKeyword(in, word, "after");
+}
+
+void readNextWord(std::istream& in, std::string& word)
+{
+  word.clear();
+  readColumnName(in, word);
+}
+
+void readDisjunction(std::istream& in, const babinov::Table& table, std::string& word, babinov::Condition& condition,
+  babinov::Vector< babinov::DataType >* parameters = nullptr);
+
+void readOperand(std::istream& in, const babinov::Table& table, std::string& word, babinov::Condition& condition,
+  babinov::Vector< babinov::DataType >* parameters)
+{
+  skipBlanks(in);
+  if (word.empty() && (in.peek() == '('))
+  {
+    in.get();
+    readNextWord(in, word);
+    readDisjunction(in, table, word, condition, parameters);
+    skipBlanks(in);
+    if (!word.empty() || (in.peek() != ')'))
+    {
+      throw std::invalid_argument("<ERROR: INVALID CONDITION>");
+    }
+    in.get();
+  }
+  else if (isKeyword(in, word, "not"))
+  {
+    readNextWord(in, word);
+    babinov::Condition operand;
+    readOperand(in, table, word, operand, parameters);
+    condition = babinov::Condition(babinov::LOGICAL_NOT, { operand });
+    return;
+  }
+  else
+  {
+    readConditionBody(in, table, word, condition, parameters);
+  }
+  readNextWord(in, word);
+}
+
+void readConjunction(std::istream& in, const babinov::Table& table, std::string& word, babinov::Condition& condition,
+  babinov::Vector< babinov::DataType >* parameters)
+{
+  babinov::Vector< babinov::Condition > operands;
+  babinov::Condition operand;
+  readOperand(in, table, word, operand, parameters);
+  operands.pushBack(operand);
+  while (isKeyword(in, word, "and"))
+  {
+    readNextWord(in, word);
+    readOperand(in, table, word, operand, parameters);
+    operands.pushBack(operand);
+  }
+  condition = (operands.size() == 1) ? operands[0] : babinov::Condition(babinov::LOGICAL_AND, operands);
+}
+
+void readDisjunction(std::istream& in, const babinov::Table& table, std::string& word, babinov::Condition& condition,
+  babinov::Vector< babinov::DataType >* parameters)
+{
+  babinov::Vector< babinov::Condition > operands;
+  babinov::Condition operand;
+  readConjunction(in, table, word, operand, parameters);
+  operands.pushBack(operand);
+  while (isKeyword(in, word, "or"))
+  {
+    readNextWord(in, word);
+    readConjunction(in, table, word, operand, parameters);
+    operands.pushBack(operand);
+  }
+  condition = (operands.size() == 1) ? operands[0] : babinov::Condition(babinov::LOGICAL_OR, operands);
+}
+
+void readCondition(std::istream& in, const babinov::Table& table, babinov::Condition& condition,
+  babinov::Vector< babinov::DataType >* parameters = nullptr)
+{
+  std::string word;
+  readColumnName(in, word);
+  readDisjunction(in, table, word, condition, parameters);
+  if (!word.empty() || !isLineEnd(in))
+  {
+    throw std::invalid_argument("<ERROR: INVALID CONDITION>");
+  }
+}
+
+struct SelectClauses
+{
+  bool hasOrder;
+  babinov::Table::SortOrder order;
+  size_t limit;
+  size_t offset;
+  bool hasCursor;
+  size_t cursor;
+  size_t limitParameter;
+  size_t offsetParameter;
+  size_t cursorParameter;
+};
+
+bool readCount(const babinov::Vector< std::string >& tokens, size_t pos, size_t& count)
+{
+  if (pos >= tokens.size())
+  {
+    return false;
+  }
+  return babinov::parseNumber(tokens[pos], count) == babinov::PARSE_OK;
+}
+
+bool readCountArgument(const babinov::Vector< std::string >& tokens, size_t pos, size_t& count, size_t& parameter,
+  babinov::Vector< babinov::DataType >* parameters)
+{
+  if (!parameters || (pos >= tokens.size()) || (tokens[pos] != "?"))
+  {
+    return readCount(tokens, pos, count);
+  }
+  parameter = parameters->size();
+  parameters->pushBack(babinov::INTEGER);
+  count = 1;
+  return true;
+}
+
+void bindCount(const babinov::Vector< std::string >& arguments, size_t parameter, size_t& count, const char* error)
+{
+  if (parameter == babinov::NO_PARAMETER)
+  {
+    return;
+  }
+  if (!readCount(arguments, parameter, count))
+  {
+    throw std::invalid_argument(error);
+  }
+}
+
+void readSelectClauses(std::istream& in, const babinov::Table& table, std::string keyword, SelectClauses& clauses,
+  babinov::Vector< babinov::DataType >* parameters)
+{
+  babinov::Vector< std::string > tokens;
+  if (!keyword.empty())
+  {
+    tokens.pushBack(keyword);
+  }
+  while (!isLineEnd(in))
+  {
+    std::string token;
+    in >> token;
+    tokens.pushBack(token);
+  }
+  size_t pos = 0;
+  if ((pos < tokens.size()) && (toLower(tokens[pos]) == "order"))
+  {
+    if ((pos + 2 >= tokens.size()) || (toLower(tokens[pos + 1]) != "by"))
+    {
+      throw std::invalid_argument("<ERROR: INVALID ORDER>");
+    }
+    try
+    {
+      clauses.order.columnIndex = table.getColumnIndex(tokens[pos + 2]);
+    }
+    catch (const std::out_of_range&)
+    {
+      throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+    }
+    clauses.hasOrder = true;
+    pos += 3;
+    std::string direction = (pos < tokens.size()) ? toLower(tokens[pos]) : std::string();
+    if ((direction == "asc") || (direction == "desc"))
+    {
+      clauses.order.isDescending = direction == "desc";
+      ++pos;
+    }
+  }
+  while (pos < tokens.size())
+  {
+    std::string clause = toLower(tokens[pos]);
+    if (clause == "limit")
+    {
+      if ((!readCountArgument(tokens, pos + 1, clauses.limit, clauses.limitParameter, parameters)) || !clauses.limit)
+      {
+        throw std::invalid_argument("<ERROR: INVALID LIMIT>");
+      }
+    }
+    else if (clause == "offset")
+    {
+      if (!readCountArgument(tokens, pos + 1, clauses.offset, clauses.offsetParameter, parameters))
+      {
+        throw std::invalid_argument("<ERROR: INVALID OFFSET>");
+      }
+    }
+    else if (clause == "after")
+    {
+      if ((!readCountArgument(tokens, pos + 1, clauses.cursor, clauses.cursorParameter, parameters))
+        || clauses.hasOrder)
+      {
+        throw std::invalid_argument("<ERROR: INVALID CURSOR>");
+      }
+      clauses.hasCursor = true;
+    }
+    else
+    {
+      break;
+    }
+    pos += 2;
+  }
+  if (pos != tokens.size())
+  {
+    throw std::invalid_argument("<ERROR: INVALID ORDER>");
+  }
+}
+
+void readProjection(std::istream& in, const babinov::Table& table, babinov::Table::Projection& columns)
+{
+  skipBlanks(in);
+  if (in.peek() != '[')
+  {
+    for (size_t i = 0; i < table.getColumns().size(); ++i)
+    {
+      columns.pushBack(i);
+    }
+    return;
+  }
+  in.get();
+  babinov::Vector< std::string > names;
+  while (true)
+  {
+    std::string name;
+    readColumnName(in, name);
+    skipBlanks(in);
+    if (name.empty())
+    {
+      throw std::invalid_argument("<ERROR: INVALID PROJECTION>");
+    }
+    names.pushBack(name);
+    if (in.peek() != ',')
+    {
+      break;
+    }
+    in.get();
+  }
+  if (in.peek() != ']')
+  {
+    throw std::invalid_argument("<ERROR: INVALID PROJECTION>");
+  }
+  in.get();
+  try
+  {
+    columns = table.makeProjection(names);
+  }
+  catch (const std::out_of_range&)
+  {
+    throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+  }
+}
+
+void readAggregate(const std::string& token, const babinov::Table& table, babinov::Aggregate& aggregate)
+{
+  size_t open = token.find('(');
+  if ((open == std::string::npos) || (token.back() != ')'))
+  {
+    throw std::invalid_argument("<ERROR: INVALID AGGREGATE>");
+  }
+  std::string name = token.substr(0, open);
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  auto function = babinov::AGGREGATE_FUNCTIONS_FROM_STR.find(name);
+  if (function == babinov::AGGREGATE_FUNCTIONS_FROM_STR.cend())
+  {
+    throw std::invalid_argument("<ERROR: INVALID AGGREGATE>");
+  }
+  aggregate.function = (*function).second;
+  std::string columnName = token.substr(open + 1, token.size() - open - 2);
+  if (columnName == "*")
+  {
+    if (aggregate.function != babinov::COUNT)
+    {
+      throw std::invalid_argument("<ERROR: INVALID AGGREGATE>");
+    }
+    aggregate.columnIndex = 0;
+    return;
+  }
+  try
+  {
+    aggregate.columnIndex = table.getColumnIndex(columnName);
+  }
+  catch (const std::out_of_range&)
+  {
+    throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+  }
+  if ((aggregate.function != babinov::COUNT) && (getColumnType(table, columnName) == babinov::TEXT))
+  {
+    throw std::invalid_argument("<ERROR: INVALID AGGREGATE>");
+  }
+}
+
+bool readAggregates(std::istream& in, const babinov::Table& table, babinov::Vector< babinov::Aggregate >& aggregates,
+  babinov::Condition& condition)
+{
+  bool hasCondition = false;
+  skipBlanks(in);
+  while (in && (in.peek() != '\n') && (in.peek() != EOF))
+  {
+    std::string token;
+    in >> token;
+    std::string keyword = token;
+    std::transform(keyword.begin(), keyword.end(), keyword.begin(), ::tolower);
+    if (keyword == "where")
+    {
+      readCondition(in, table, condition);
+      hasCondition = true;
+      break;
+    }
+    babinov::Aggregate aggregate;
+    readAggregate(token, table, aggregate);
+    aggregates.pushBack(aggregate);
+    skipBlanks(in);
+  }
+  if (aggregates.isEmpty())
+  {
+    throw std::invalid_argument("<ERROR: INVALID AGGREGATE>");
+  }
+  return hasCondition;
+}
+
+void printAggregates(std::ostream& out, const babinov::Table& table, const babinov::Vector< babinov::Aggregate >& aggregates,
+  const babinov::Vector< babinov::Accumulator >& results)
+{
+  for (size_t i = 0; i < aggregates.size(); ++i)
+  {
+    babinov::DataType dataType = table.getColumns()[aggregates[i].columnIndex].second;
+    babinov::printAggregate(out, aggregates[i].function, dataType, results[i]);
+    out << ' ';
+  }
+}
+
+struct SelectStatement
+{
+  babinov::Table::Projection columns;
+  bool hasCondition;
+  babinov::Condition condition;
+  SelectClauses clauses;
+};
+
+void readSelect(std::istream& in, const babinov::Table& table, SelectStatement& statement,
+  babinov::Vector< babinov::DataType >* parameters = nullptr)
+{
+  readProjection(in, table, statement.columns);
+  statement.hasCondition = false;
+  std::string word;
+  readColumnName(in, word);
+  bool isWhere = isKeyword(in, word, "where");
+  if (isWhere)
+  {
+    readNextWord(in, word);
+  }
+  if (isWhere || (!isSelectClause(in, word) && (!word.empty() || (in.peek() == '('))))
+  {
+    readDisjunction(in, table, word, statement.condition, parameters);
+    statement.hasCondition = true;
+  }
+  size_t none = babinov::NO_PARAMETER;
+  statement.clauses = SelectClauses{ false, { 0, false }, 0, 0, false, 0, none, none, none };
+  readSelectClauses(in, table, word, statement.clauses, parameters);
+}
+
+void finishParse(const babinov::Table& table, babinov::Condition* condition, babinov::QueryProfile* profile,
+  babinov::ProfileClock::time_point start)
+{
+  if (!profile)
+  {
+    return;
+  }
+  if (condition)
+  {
+    *condition = table.planCondition(*condition);
+  }
+  profile->parseMs += babinov::getElapsedMs(start);
+}
+
+void finishScan(babinov::QueryProfile* profile, babinov::ProfileClock::time_point start)
+{
+  if (profile)
+  {
+    profile->scanMs = babinov::getElapsedMs(start) - profile->materializeMs - profile->printMs;
+    profile->hasPhases = true;
+  }
+}
+
+void printProfiledRow(const babinov::Table& table, const babinov::Table::RowRef& row,
+  const babinov::Table::Projection& columns, std::ostringstream& buffer, babinov::QueryProfile& profile,
+  std::ostream& out)
+{
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+  buffer.str(std::string());
+  table.printRow(buffer, row, columns);
+  buffer << '\n';
+  babinov::ProfileClock::time_point materialized = babinov::ProfileClock::now();
+  out << buffer.str();
+  profile.materializeMs += std::chrono::duration< double, std::milli >(materialized - start).count();
+  profile.printMs += babinov::getElapsedMs(materialized);
+}
+
+void runSelect(const babinov::Table& table, const SelectStatement& statement, babinov::QueryProfile* profile,
+  std::ostream& out)
+{
+  using babinov::Table;
+  const SelectClauses& clauses = statement.clauses;
+  const Table::Projection& columns = statement.columns;
+  const babinov::Condition& condition = statement.condition;
+  if (profile)
+  {
+    profile->recordAccess(table, statement.hasCondition ? &condition : nullptr);
+  }
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+  std::ostringstream buffer;
+  size_t nSkipped = 0;
+  size_t nPrinted = 0;
+  size_t lastId = 0;
+  bool hasMore = false;
+  auto printRow = [&](const Table::RowRef& row)
+  {
+    if (clauses.limit && (nPrinted == clauses.limit))
+    {
+      hasMore = true;
+      return false;
+    }
+    if (profile)
+    {
+      ++profile->actualRows;
+    }
+    if (nSkipped < clauses.offset)
+    {
+      ++nSkipped;
+      return true;
+    }
+    if (profile)
+    {
+      printProfiledRow(table, row, columns, buffer, *profile, out);
+    }
+    else
+    {
+      table.printRow(out, row, columns);
+      out << '\n';
+    }
+    lastId = row.getId();
+    ++nPrinted;
+    return true;
+  };
+  size_t sortLimit = clauses.limit ? clauses.limit + clauses.offset + 1 : 0;
+  if (clauses.hasOrder)
+  {
+    try
+    {
+      if (statement.hasCondition)
+      {
+        table.forEachSorted(condition, clauses.order, sortLimit, columns, printRow);
+      }
+      else
+      {
+        table.forEachSorted(clauses.order, sortLimit, columns, printRow);
+      }
+    }
+    catch (const babinov::SortError&)
+    {
+      throw std::invalid_argument("<ERROR: CANNOT SORT>");
+    }
+  }
+  else if (clauses.hasCursor && statement.hasCondition)
+  {
+    table.forEachAfter(clauses.cursor, condition, printRow);
+  }
+  else if (clauses.hasCursor)
+  {
+    table.forEachAfter(clauses.cursor, printRow);
+  }
+  else if (statement.hasCondition)
+  {
+    table.forEach(condition, printRow);
+  }
+  else
+  {
+    table.forEach(printRow);
+  }
+  finishScan(profile, start);
+  if (hasMore && !clauses.hasOrder)
+  {
+    out << "<CURSOR: " << lastId << '>' << '\n';
+  }
+}
+
+struct UpdateStatement
+{
+  bool hasCondition;
+  babinov::Condition condition;
+  size_t id;
+  size_t idParameter;
+  std::string columnName;
+  std::string value;
+  size_t valueParameter;
+};
+
+void readUpdate(std::istream& in, const babinov::Table& table, UpdateStatement& statement,
+  babinov::Vector< babinov::DataType >* parameters = nullptr)
+{
+  statement.hasCondition = false;
+  statement.id = 0;
+  statement.idParameter = babinov::NO_PARAMETER;
+  statement.valueParameter = babinov::NO_PARAMETER;
+  skipBlanks(in);
+  if (std::isalpha(in.peek()))
+  {
+    std::string word;
+    readColumnName(in, word);
+    if (toLower(word) != "where")
+    {
+      throw std::invalid_argument("<ERROR: INVALID ID>");
+    }
+    readNextWord(in, word);
+    readDisjunction(in, table, word, statement.condition, parameters);
+    if (!isKeyword(in, word, "set"))
+    {
+      throw std::invalid_argument("<ERROR: INVALID CONDITION>");
+    }
+    statement.hasCondition = true;
+  }
+  else if (parameters && (in.peek() == '?'))
+  {
+    in.get();
+    statement.idParameter = parameters->size();
+    parameters->pushBack(babinov::PK);
+  }
+  else if (!(in >> statement.id))
+  {
+    throw std::invalid_argument("<ERROR: INVALID ID>");
+  }
+  in >> statement.columnName;
+  babinov::DataType dataType = babinov::PK;
+  try
+  {
+    dataType = getColumnType(table, statement.columnName);
+  }
+  catch (const std::out_of_range&)
+  {
+    throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+  }
+  readArgument(in, statement.value, dataType, parameters, statement.valueParameter);
+}
+
+void checkUpdate(const babinov::Table& table, const UpdateStatement& statement)
+{
+  if (statement.columnName == "id")
+  {
+    throw std::invalid_argument("<ERROR: CANNOT UPDATE ID FIELD>");
+  }
+  babinov::DataType dataType = babinov::PK;
+  try
+  {
+    dataType = getColumnType(table, statement.columnName);
+  }
+  catch (const std::out_of_range&)
+  {
+    throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+  }
+  if (babinov::checkValue(statement.value, dataType) != babinov::PARSE_OK)
+  {
+    throw std::invalid_argument("<ERROR: INVALID VALUE>");
+  }
+  if ((!statement.hasCondition) && (!table.hasRow(statement.id)))
+  {
+    throw std::invalid_argument("<ERROR: INVALID ID>");
+  }
+}
+
+void runUpdate(babinov::Table& table, babinov::WriteAheadLog* log, const UpdateStatement& statement,
+  babinov::QueryProfile* profile, std::ostream& out)
+{
+  if (profile && statement.hasCondition)
+  {
+    profile->recordAccess(table, &statement.condition);
+  }
+  else if (profile)
+  {
+    profile->hasAccess = true;
+    profile->access = babinov::Table::AccessPath{ babinov::ID_LOOKUP, 0, 1.0 };
+  }
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+  checkUpdate(table, statement);
+  writeLog(log, [&](babinov::WriteAheadLog& dest)
+  {
+    if (statement.hasCondition)
+    {
+      dest.logUpdate(statement.condition, statement.columnName, statement.value);
+    }
+    else
+    {
+      dest.logUpdate(statement.id, statement.columnName, statement.value);
+    }
+  });
+  size_t nUpdated = 0;
+  if (statement.hasCondition)
+  {
+    nUpdated = table.update(statement.condition, statement.columnName, statement.value);
+  }
+  else
+  {
+    nUpdated = table.update(statement.id, statement.columnName, statement.value);
+  }
+  if (profile)
+  {
+    profile->actualRows = nUpdated;
   }
-  if (!in)
+  finishScan(profile, start);
+  if (!nUpdated)
+  {
+    out << "<THERE ARE NOT ROWS WITH SPECIFIED CONDITION>" << '\n';
+    return;
+  }
+  out << "<SUCCESSFULLY UPDATED>" << '\n';
+}
+
+void runInsert(babinov::Table& table, babinov::WriteAheadLog* log, const babinov::Table::Row& row,
+  babinov::QueryProfile* profile, std::ostream& out)
+{
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+  if (!table.isCorrectRow(row))
   {
     throw std::invalid_argument("<ERROR: INVALID VALUE>");
   }
+  writeLog(log, [&](babinov::WriteAheadLog& dest)
+  {
+    dest.logInsert(row);
+  });
+  table.insert(row);
+  finishScan(profile, start);
+  out << "<SUCCESSFULLY INSERTED>" << '\n';
+}
+
+void runDelete(babinov::Table& table, babinov::WriteAheadLog* log, const babinov::Condition& condition,
+  babinov::QueryProfile* profile, std::ostream& out)
+{
+  if (profile)
+  {
+    profile->recordAccess(table, &condition);
+  }
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+  writeLog(log, [&](babinov::WriteAheadLog& dest)
+  {
+    dest.logDelete(condition);
+  });
+  size_t nRows = table.size();
+  bool isDeleted = table.del(condition);
+  if (profile)
+  {
+    profile->actualRows = nRows - table.size();
+  }
+  finishScan(profile, start);
+  if (!isDeleted)
+  {
+    out << "<THERE ARE NOT ROWS WITH SPECIFIED CONDITION>" << '\n';
+    return;
+  }
+  out << "<SUCCESSFULLY DELETED>" << '\n';
+}
+
+void runCount(const babinov::Table& table, const babinov::Condition* condition, babinov::QueryProfile* profile,
+  std::ostream& out)
+{
+  if (profile)
+  {
+    profile->recordAccess(table, condition);
+  }
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+  size_t nRows = condition ? table.count(*condition) : table.size();
+  if (profile)
+  {
+    profile->actualRows = nRows;
+  }
+  finishScan(profile, start);
+  out << nRows << '\n';
 }
 
-void readCondition(std::istream& in, const babinov::Table& table, std::string& columnName, std::string& value)
+void bindCondition(const babinov::Table& table, const babinov::Vector< std::string >& arguments,
+  babinov::Condition& condition, babinov::QueryProfile* profile)
 {
-  std::getline(in, columnName, '=');
+  babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
   try
   {
-    babinov::DataType dataType = getColumnType(table, columnName);
-    readValue(in, value, dataType);
+    condition.bind(arguments);
   }
-  catch (const std::out_of_range&)
+  catch (const std::exception&)
   {
-    throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+    throw std::invalid_argument("<ERROR: INVALID VALUE>");
+  }
+  if (condition.isCompound() && !condition.isPlanned())
+  {
+    condition = table.planCondition(condition);
+  }
+  if (profile)
+  {
+    profile->parseMs += babinov::getElapsedMs(start);
+  }
+}
+
+bool isSameColumns(const babinov::Vector< babinov::Table::Column >& lhs,
+  const babinov::Vector< babinov::Table::Column >& rhs)
+{
+  if (lhs.size() != rhs.size())
+  {
+    return false;
+  }
+  for (size_t i = 0; i < lhs.size(); ++i)
+  {
+    if (lhs[i] != rhs[i])
+    {
+      return false;
+    }
   }
+  return true;
 }
 
 namespace babinov
 {
-  void execCmdTables(const HashTable< std::string, Table >& tables, std::ostream& out)
+  void execCmdTables(const HashMap< std::string, Table >& tables, std::ostream& out)
   {
     for (auto it = tables.cbegin(); it != tables.cend(); ++it)
     {
@@ -71,7 +944,7 @@ namespace babinov
     }
   }
 
-  void execCmdLoad(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdLoad(HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out)
   {
     std::string fileName;
     std::string tableName;
@@ -80,37 +953,99 @@ namespace babinov
     {
       throw std::invalid_argument("<ERROR: INVALID TABLE NAME>");
     }
-    std::ifstream file(fileName);
-    if (!file.is_open())
-    {
-      throw std::invalid_argument("<ERROR: FILE DOESN'T EXIST>");
-    }
     if (tables.find(tableName) != tables.end())
     {
       throw std::invalid_argument("<ERROR: TABLE ALREADY EXISTS>");
     }
+    auto start = std::chrono::steady_clock::now();
     Table newTable;
-    file >> newTable;
-    if ((!file.eof()) || (!newTable.getColumns().size()))
+    try
+    {
+      newTable = loadTable(fileName);
+    }
+    catch (const std::runtime_error&)
+    {
+      throw std::invalid_argument("<ERROR: FILE DOESN'T EXIST>");
+    }
+    catch (const std::invalid_argument&)
     {
       throw std::invalid_argument("<ERROR: INVALID TABLE>");
     }
+    std::string logFileName = getLogFileName(fileName);
+    size_t nReplayed = 0;
+    try
+    {
+      uint64_t fingerprint = getFileFingerprint(fileName);
+      nReplayed = replayLog(logFileName, newTable, fingerprint);
+      logs[tableName] = openLog(logFileName, newTable.getLastId(), fingerprint);
+    }
+    catch (const std::invalid_argument&)
+    {
+      throw std::invalid_argument("<ERROR: INVALID LOG>");
+    }
+    catch (const std::runtime_error&)
+    {
+      throw std::invalid_argument("<ERROR: CANNOT OPEN LOG>");
+    }
+    std::chrono::duration< double > elapsed = std::chrono::steady_clock::now() - start;
+    size_t nRows = newTable.size();
     tables[tableName] = std::move(newTable);
     out << "<SUCCESSFULLY LOADED>" << '\n';
+    if (nReplayed)
+    {
+      out << "<" << nReplayed << " LOG RECORDS REPLAYED>" << '\n';
+    }
+    out << "<" << nRows << " ROWS IN " << elapsed.count() << " SEC";
+    if (elapsed.count() > 0.0)
+    {
+      out << ", " << static_cast< size_t >(nRows / elapsed.count()) << " ROWS/SEC";
+    }
+    out << ">" << '\n';
   }
 
-  void execCmdSave(const HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdSave(const HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out)
   {
     std::string tableName;
     readTableName(in, tables, tableName);
     std::string fileName;
     in >> fileName;
-    std::ofstream file(fileName);
-    file << tables.at(tableName);
+    bool isBinary = false;
+    skipBlanks(in);
+    if (in && (in.peek() != '\n') && (in.peek() != EOF))
+    {
+      std::string format;
+      in >> format;
+      if (format == "binary")
+      {
+        isBinary = true;
+      }
+      else if (format != "text")
+      {
+        throw std::invalid_argument("<ERROR: INVALID FORMAT>");
+      }
+    }
+    const Table& table = tables.at(tableName);
+    uint64_t fingerprint = 0;
+    try
+    {
+      fingerprint = saveTable(table, fileName, isBinary);
+    }
+    catch (const std::runtime_error&)
+    {
+      throw std::invalid_argument("<ERROR: CANNOT SAVE TABLE>");
+    }
+    try
+    {
+      logs[tableName] = resetLog(getLogFileName(fileName), table.getLastId(), fingerprint);
+    }
+    catch (const std::runtime_error&)
+    {
+      throw std::invalid_argument("<ERROR: CANNOT OPEN LOG>");
+    }
     out << "<SUCCESSFULLY SAVED>" << '\n';
   }
 
-  void execCmdCreate(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdCreate(HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out)
   {
     std::string tableName;
     in >> tableName;
@@ -144,8 +1079,10 @@ namespace babinov
     }
   }
 
-  void execCmdInsert(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdInsert(HashMap< std::string, Table >& tables, LogMap& logs, QueryProfile& profile, std::istream& in,
+    std::ostream& out)
   {
+    ProfileClock::time_point start = ProfileClock::now();
     std::string tableName;
     readTableName(in, tables, tableName);
     Table& table = tables[tableName];
@@ -157,34 +1094,175 @@ namespace babinov
       readValue(in, data, columns[i].second);
       row.pushBack(data);
     }
-    try
+    QueryProfile* active = profile.isActive() ? &profile : nullptr;
+    finishParse(table, nullptr, active, start);
+    runInsert(table, findLog(logs, tableName), row, active, out);
+  }
+
+  void execCmdSelect(const HashMap< std::string, Table >& tables, QueryProfile& profile, std::istream& in,
+    std::ostream& out)
+  {
+    ProfileClock::time_point start = ProfileClock::now();
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    const Table& table = tables.at(tableName);
+    SelectStatement statement;
+    readSelect(in, table, statement);
+    QueryProfile* active = profile.isActive() ? &profile : nullptr;
+    finishParse(table, statement.hasCondition ? &statement.condition : nullptr, active, start);
+    runSelect(table, statement, active, out);
+  }
+
+  void execCmdSortMemory(std::istream& in, std::ostream& out)
+  {
+    size_t megabytes = 0;
+    in >> megabytes;
+    if ((!in) || (!megabytes))
     {
-      table.insert(std::move(row));
-      out << "<SUCCESSFULLY INSERTED>" << '\n';
+      throw std::invalid_argument("<ERROR: INVALID MEMORY LIMIT>");
     }
-    catch (const std::invalid_argument&)
+    setSortMemoryLimit(megabytes << 20);
+    out << "<SORT MEMORY LIMIT CHANGED>" << '\n';
+  }
+
+  void execCmdCount(const HashMap< std::string, Table >& tables, QueryProfile& profile, std::istream& in,
+    std::ostream& out)
+  {
+    ProfileClock::time_point start = ProfileClock::now();
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    const Table& table = tables.at(tableName);
+    QueryProfile* active = profile.isActive() ? &profile : nullptr;
+    skipBlanks(in);
+    if (in && (in.peek() != '\n') && (in.peek() != EOF))
+    {
+      Condition condition;
+      readCondition(in, table, condition);
+      finishParse(table, &condition, active, start);
+      runCount(table, &condition, active, out);
+    }
+    else
     {
-      throw std::invalid_argument("<ERROR: INVALID VALUE>");
+      finishParse(table, nullptr, active, start);
+      runCount(table, nullptr, active, out);
     }
   }
 
-  void execCmdSelect(const HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdAggregate(const HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  {
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    const Table& table = tables.at(tableName);
+    Vector< Aggregate > aggregates;
+    Condition condition;
+    bool hasCondition = readAggregates(in, table, aggregates, condition);
+    Vector< Accumulator > results = hasCondition ? table.aggregate(aggregates, condition) : table.aggregate(aggregates);
+    out << "[ ";
+    printAggregates(out, table, aggregates, results);
+    out << ']' << '\n';
+  }
+
+  void execCmdGroup(const HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out)
   {
     std::string tableName;
     readTableName(in, tables, tableName);
     const Table& table = tables.at(tableName);
+    using del = StringDelimiterI;
     std::string columnName;
-    std::string value;
-    in.get();
-    readCondition(in, table, columnName, value);
+    in >> del::insensitive("by") >> columnName;
+    if (!in)
+    {
+      throw std::invalid_argument("<ERROR: INVALID GROUP>");
+    }
+    size_t columnIndex = 0;
     try
     {
-      Vector< Table::Row > selection = table.select(columnName, value);
-      for (size_t i = 0; i < selection.size(); ++i)
+      columnIndex = table.getColumnIndex(columnName);
+    }
+    catch (const std::out_of_range&)
+    {
+      throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+    }
+    Vector< Aggregate > aggregates;
+    Condition condition;
+    bool hasCondition = readAggregates(in, table, aggregates, condition);
+    Vector< Table::Group > groups;
+    if (hasCondition)
+    {
+      groups = table.groupBy(columnIndex, aggregates, condition);
+    }
+    else
+    {
+      groups = table.groupBy(columnIndex, aggregates);
+    }
+    bool isText = table.getColumns()[columnIndex].second == TEXT;
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+      out << "[ ";
+      if (isText)
+      {
+        out << '\"' << groups[i].key << '\"';
+      }
+      else
+      {
+        out << groups[i].key;
+      }
+      out << ' ';
+      printAggregates(out, table, aggregates, groups[i].accumulators);
+      out << ']' << '\n';
+    }
+  }
+
+  void execCmdJoin(const HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  {
+    std::string leftName;
+    std::string rightName;
+    readTableName(in, tables, leftName);
+    readTableName(in, tables, rightName);
+    const Table& left = tables.at(leftName);
+    const Table& right = tables.at(rightName);
+    using del = StringDelimiterI;
+    std::string leftColumn;
+    std::string rightColumn;
+    in >> del::insensitive("on");
+    readColumnName(in, leftColumn);
+    skipBlanks(in);
+    in >> CharDelimiterI::sensitive('=');
+    readColumnName(in, rightColumn);
+    if (!in)
+    {
+      throw std::invalid_argument("<ERROR: INVALID JOIN>");
+    }
+    JoinMode mode = AUTO_JOIN;
+    skipBlanks(in);
+    if (in && (in.peek() != '\n') && (in.peek() != EOF))
+    {
+      std::string modeName;
+      in >> modeName;
+      if (modeName == "hash")
+      {
+        mode = HASH_JOIN;
+      }
+      else if (modeName == "radix")
       {
-        table.printRow(out, selection[i]);
-        out << '\n';
+        mode = RADIX_JOIN;
       }
+      else
+      {
+        throw std::invalid_argument("<ERROR: INVALID JOIN>");
+      }
+    }
+    auto printPair = [&out](const Table::RowRef& leftRow, const Table::RowRef& rightRow)
+    {
+      leftRow.print(out);
+      out << ' ';
+      rightRow.print(out);
+      out << '\n';
+      return true;
+    };
+    try
+    {
+      hashJoin(left, leftColumn, right, rightColumn, printPair, mode);
     }
     catch (const std::out_of_range&)
     {
@@ -192,11 +1270,11 @@ namespace babinov
     }
     catch (const std::invalid_argument&)
     {
-      throw std::invalid_argument("<ERROR: INVALID VALUE>");
+      throw std::invalid_argument("<ERROR: INCOMPATIBLE COLUMNS>");
     }
   }
 
-  void execCmdClose(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdClose(HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out)
   {
     std::string tableName;
     readTableName(in, tables, tableName);
@@ -206,85 +1284,336 @@ namespace babinov
     if ((answer == "Y") || (answer == "y"))
     {
       tables.erase(tableName);
+      logs.erase(tableName);
       out << "<TABLE SUCCESFULLY CLOSED>" << '\n';
     }
   }
 
-  void execCmdUpdate(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdUpdate(HashMap< std::string, Table >& tables, LogMap& logs, QueryProfile& profile, std::istream& in,
+    std::ostream& out)
   {
+    ProfileClock::time_point start = ProfileClock::now();
     std::string tableName;
     readTableName(in, tables, tableName);
     Table& table = tables[tableName];
-    size_t id = 0;
-    std::string columnName;
-    std::string value;
-    in >> id;
-    if (!in)
+    UpdateStatement statement;
+    readUpdate(in, table, statement);
+    QueryProfile* active = profile.isActive() ? &profile : nullptr;
+    finishParse(table, statement.hasCondition ? &statement.condition : nullptr, active, start);
+    runUpdate(table, findLog(logs, tableName), statement, active, out);
+  }
+
+  void execCmdDelete(HashMap< std::string, Table >& tables, LogMap& logs, QueryProfile& profile, std::istream& in,
+    std::ostream& out)
+  {
+    ProfileClock::time_point start = ProfileClock::now();
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    Table& table = tables[tableName];
+    Condition condition;
+    in.get();
+    readCondition(in, table, condition);
+    QueryProfile* active = profile.isActive() ? &profile : nullptr;
+    finishParse(table, &condition, active, start);
+    runDelete(table, findLog(logs, tableName), condition, active, out);
+  }
+
+  void execCmdClear(HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out)
+  {
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    writeLog(findLog(logs, tableName), [](WriteAheadLog& dest)
     {
-      throw std::invalid_argument("<ERROR: INVALID ID>");
+      dest.logClear();
+    });
+    tables[tableName].clear();
+    out << "<SUCCESSFULLY CLEARED>" << '\n';
+  }
+
+  void execCmdIndex(HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  {
+    std::string action;
+    in >> action;
+    if ((action != "create") && (action != "drop"))
+    {
+      throw std::invalid_argument("<INVALID COMMAND>");
     }
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    Table& table = tables[tableName];
+    std::string columnName;
     in >> columnName;
-    bool isUpdated = false;
+    IndexType indexType = HASH_INDEX;
+    skipBlanks(in);
+    if ((action == "create") && in && (in.peek() != '\n') && (in.peek() != EOF))
+    {
+      std::string indexTypeName;
+      in >> indexTypeName;
+      if (indexTypeName == "ordered")
+      {
+        indexType = ORDERED_INDEX;
+      }
+      else if (indexTypeName != "hash")
+      {
+        throw std::invalid_argument("<ERROR: INVALID INDEX TYPE>");
+      }
+    }
     try
     {
-      readValue(in, value, getColumnType(table, columnName));
-      isUpdated = table.update(id, columnName, std::move(value));
+      if (action == "create")
+      {
+        table.createIndex(columnName, indexType);
+        out << "<INDEX SUCCESSFULLY CREATED>" << '\n';
+      }
+      else if (table.dropIndex(columnName))
+      {
+        out << "<INDEX SUCCESSFULLY DROPPED>" << '\n';
+      }
+      else
+      {
+        out << "<ERROR: INDEX DOESN'T EXIST>" << '\n';
+      }
     }
     catch (const std::out_of_range&)
     {
       throw std::invalid_argument("<ERROR: INVALID COLUMN>");
     }
-    catch (const std::invalid_argument&)
+    catch (const std::logic_error&)
     {
-      throw std::invalid_argument("<ERROR: INVALID VALUE>");
+      throw std::invalid_argument("<ERROR: INDEX ALREADY EXISTS>");
     }
-    catch (const std::logic_error&)
+  }
+
+  void execCmdWal(const HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out)
+  {
+    std::string tableName;
+    readTableName(in, tables, tableName);
+    WriteAheadLog* log = findLog(logs, tableName);
+    if (!log)
     {
-      throw std::invalid_argument("<ERROR: CANNOT UPDATE ID FIELD>");
+      throw std::invalid_argument("<ERROR: TABLE HAS NO LOG>");
     }
-    if (!isUpdated)
+    std::string policyName;
+    in >> policyName;
+    if (policyName == "always")
     {
-      throw std::invalid_argument("<ERROR: INVALID ID>");
+      log->setSyncPolicy(SYNC_ALWAYS);
+    }
+    else if (policyName == "off")
+    {
+      log->setSyncPolicy(SYNC_OFF);
     }
-    out << "<SUCCESSFULLY UPDATED>" << '\n';
+    else if (policyName == "group")
+    {
+      size_t groupDelayMs = WriteAheadLog::DEFAULT_GROUP_DELAY_MS;
+      skipBlanks(in);
+      if (in && (in.peek() != '\n') && (in.peek() != EOF) && (!(in >> groupDelayMs)))
+      {
+        throw std::invalid_argument("<ERROR: INVALID SYNC POLICY>");
+      }
+      log->setSyncPolicy(SYNC_GROUP, groupDelayMs);
+    }
+    else
+    {
+      throw std::invalid_argument("<ERROR: INVALID SYNC POLICY>");
+    }
+    out << "<SYNC POLICY CHANGED>" << '\n';
   }
 
-  void execCmdDelete(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdThreads(std::istream& in, std::ostream& out)
   {
-    std::string tableName;
-    readTableName(in, tables, tableName);
-    Table& table = tables[tableName];
-    std::string columnName;
-    std::string value;
-    in.get();
-    readCondition(in, table, columnName, value);
-    try
+    size_t nThreads = 0;
+    in >> nThreads;
+    if ((!in) || (!nThreads))
+    {
+      throw std::invalid_argument("<ERROR: INVALID THREAD COUNT>");
+    }
+    getScanPool().resize(nThreads);
+    out << "<THREAD COUNT CHANGED>" << '\n';
+  }
+
+  void execCmdPrepare(const HashMap< std::string, Table >& tables, StatementMap& statements, std::istream& in,
+    std::ostream& out)
+  {
+    std::string name;
+    std::string command;
+    in >> name >> command;
+    if (!isCorrectName(name))
+    {
+      throw std::invalid_argument("<ERROR: INVALID STATEMENT NAME>");
+    }
+    if ((command != "select") && (command != "count") && (command != "insert") && (command != "update")
+      && (command != "delete"))
+    {
+      throw std::invalid_argument("<ERROR: INVALID STATEMENT>");
+    }
+    PreparedStatement statement;
+    readTableName(in, tables, statement.tableName);
+    const Table& table = tables.at(statement.tableName);
+    statement.columns = table.getColumns();
+    Vector< DataType >* parameters = &statement.parameters;
+    if (command == "select")
+    {
+      SelectStatement select;
+      readSelect(in, table, select, parameters);
+      statement.execute = [select](Table& table, WriteAheadLog*, const Vector< std::string >& arguments,
+        QueryProfile* profile, std::ostream& out) mutable
+      {
+        bindCondition(table, arguments, select.condition, profile);
+        SelectClauses& clauses = select.clauses;
+        bindCount(arguments, clauses.limitParameter, clauses.limit, "<ERROR: INVALID LIMIT>");
+        bindCount(arguments, clauses.offsetParameter, clauses.offset, "<ERROR: INVALID OFFSET>");
+        bindCount(arguments, clauses.cursorParameter, clauses.cursor, "<ERROR: INVALID CURSOR>");
+        if (!clauses.limit && (clauses.limitParameter != NO_PARAMETER))
+        {
+          throw std::invalid_argument("<ERROR: INVALID LIMIT>");
+        }
+        runSelect(table, select, profile, out);
+      };
+    }
+    else if (command == "count")
     {
-      bool isDeleted = table.del(columnName, value);
-      if (isDeleted)
+      Condition condition;
+      bool hasCondition = !isLineEnd(in);
+      if (hasCondition)
       {
-        out << "<SUCCESSFULLY DELETED>" << '\n';
+        readCondition(in, table, condition, parameters);
       }
-      else
+      statement.execute = [condition, hasCondition](Table& table, WriteAheadLog*,
+        const Vector< std::string >& arguments, QueryProfile* profile, std::ostream& out) mutable
+      {
+        bindCondition(table, arguments, condition, profile);
+        runCount(table, hasCondition ? &condition : nullptr, profile, out);
+      };
+    }
+    else if (command == "delete")
+    {
+      Condition condition;
+      readCondition(in, table, condition, parameters);
+      statement.execute = [condition](Table& table, WriteAheadLog* log, const Vector< std::string >& arguments,
+        QueryProfile* profile, std::ostream& out) mutable
+      {
+        bindCondition(table, arguments, condition, profile);
+        runDelete(table, log, condition, profile, out);
+      };
+    }
+    else if (command == "update")
+    {
+      UpdateStatement update;
+      readUpdate(in, table, update, parameters);
+      statement.execute = [update](Table& table, WriteAheadLog* log, const Vector< std::string >& arguments,
+        QueryProfile* profile, std::ostream& out) mutable
+      {
+        bindCondition(table, arguments, update.condition, profile);
+        bindCount(arguments, update.idParameter, update.id, "<ERROR: INVALID ID>");
+        if (update.valueParameter != NO_PARAMETER)
+        {
+          update.value = arguments[update.valueParameter];
+        }
+        runUpdate(table, log, update, profile, out);
+      };
+    }
+    else
+    {
+      Table::Row row;
+      Vector< size_t > positions;
+      std::string value;
+      for (size_t i = 1; i < statement.columns.size(); ++i)
       {
-        out << "<THERE ARE NOT ROWS WITH SPECIFIED CONDITION>" << '\n';
+        size_t parameter = NO_PARAMETER;
+        readArgument(in, value, statement.columns[i].second, parameters, parameter);
+        if (parameter != NO_PARAMETER)
+        {
+          positions.pushBack(row.size());
+        }
+        row.pushBack(value);
       }
+      statement.execute = [row, positions](Table& table, WriteAheadLog* log, const Vector< std::string >& arguments,
+        QueryProfile* profile, std::ostream& out) mutable
+      {
+        for (size_t i = 0; i < positions.size(); ++i)
+        {
+          row[positions[i]] = arguments[i];
+        }
+        runInsert(table, log, row, profile, out);
+      };
     }
-    catch (const std::out_of_range&)
+    statements[name] = std::move(statement);
+    out << "<SUCCESSFULLY PREPARED>" << '\n';
+  }
+
+  void execCmdExec(HashMap< std::string, Table >& tables, LogMap& logs, StatementMap& statements,
+    QueryProfile& profile, std::istream& in, std::ostream& out)
+  {
+    ProfileClock::time_point start = ProfileClock::now();
+    std::string name;
+    in >> name;
+    auto statement = statements.find(name);
+    if (statement == statements.end())
     {
-      throw std::invalid_argument("<ERROR: INVALID COLUMN>");
+      throw std::invalid_argument("<ERROR: STATEMENT DOESN'T EXIST>");
     }
-    catch (const std::invalid_argument&)
+    PreparedStatement& prepared = (*statement).second;
+    auto table = tables.find(prepared.tableName);
+    if (table == tables.end())
+    {
+      throw std::invalid_argument("<ERROR: TABLE DOESN'T EXIST>");
+    }
+    if (!isSameColumns((*table).second.getColumns(), prepared.columns))
+    {
+      throw std::invalid_argument("<ERROR: STATEMENT IS OUTDATED>");
+    }
+    Vector< std::string > arguments;
+    arguments.reserve(prepared.parameters.size());
+    for (size_t i = 0; i < prepared.parameters.size(); ++i)
+    {
+      if (isLineEnd(in))
+      {
+        throw std::invalid_argument("<ERROR: INVALID ARGUMENTS>");
+      }
+      std::string value;
+      readValue(in, value, prepared.parameters[i]);
+      arguments.pushBack(std::move(value));
+    }
+    if (!isLineEnd(in))
     {
-      throw std::invalid_argument("<ERROR: INVALID VALUE>");
+      throw std::invalid_argument("<ERROR: INVALID ARGUMENTS>");
     }
+    QueryProfile* active = profile.isActive() ? &profile : nullptr;
+    finishParse((*table).second, nullptr, active, start);
+    prepared.execute((*table).second, findLog(logs, prepared.tableName), arguments, active, out);
   }
 
-  void execCmdClear(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out)
+  void execCmdExplain(const HashMap< std::string, Table >& tables, QueryProfile& profile, std::istream& in)
   {
-    std::string tableName;
-    readTableName(in, tables, tableName);
-    tables[tableName].clear();
-    out << "<SUCCESSFULLY CLEARED>" << '\n';
+    std::string command;
+    in >> command;
+    if ((command != "select") && (command != "count"))
+    {
+      throw std::invalid_argument("<ERROR: INVALID STATEMENT>");
+    }
+    std::ostream discard(nullptr);
+    profile.isRequested = true;
+    profile.isOutputDiscarded = true;
+    if (command == "select")
+    {
+      execCmdSelect(tables, profile, in, discard);
+    }
+    else
+    {
+      execCmdCount(tables, profile, in, discard);
+    }
+  }
+
+  void execCmdProfile(QueryProfile& profile, std::istream& in, std::ostream& out)
+  {
+    std::string mode;
+    in >> mode;
+    if ((mode != "on") && (mode != "off"))
+    {
+      throw std::invalid_argument("<ERROR: INVALID PROFILE MODE>");
+    }
+    profile.isEnabled = mode == "on";
+    out << "<PROFILE MODE CHANGED>" << '\n';
   }
 }
@@ -0,0 +1,189 @@
+#include "condition.hpp"
+#include <stdexcept>
+#include <string>
+
+#include "value_parser.hpp"
+
+namespace babinov
+{
+  Condition::Condition():
+    logicalOperation_(PREDICATE),
+    operands_(),
+    columnIndex_(0),
+    dataType_(PK),
+    operation_(EQUAL),
+    integer_(0),
+    real_(0.0),
+    text_(),
+    upperInteger_(0),
+    upperReal_(0.0),
+    upperText_(),
+    parameter_(NO_PARAMETER),
+    upperParameter_(NO_PARAMETER),
+    isPlanned_(false)
+  {}
+
+  Condition::Condition(size_t columnIndex, DataType dataType, const std::string& value):
+    Condition(columnIndex, dataType, EQUAL, value)
+  {}
+
+  Condition::Condition(size_t columnIndex, DataType dataType, CompareOperation operation,
+    const std::string& value, const std::string& upperValue):
+    logicalOperation_(PREDICATE),
+    operands_(),
+    columnIndex_(columnIndex),
+    dataType_(dataType),
+    operation_(operation),
+    integer_(0),
+    real_(0.0),
+    text_(),
+    upperInteger_(0),
+    upperReal_(0.0),
+    upperText_(),
+    parameter_(NO_PARAMETER),
+    upperParameter_(NO_PARAMETER),
+    isPlanned_(false)
+  {
+    setValue(value, integer_, real_, text_);
+    if (operation == BETWEEN)
+    {
+      setValue(upperValue, upperInteger_, upperReal_, upperText_);
+    }
+    else
+    {
+      upperInteger_ = integer_;
+      upperReal_ = real_;
+      upperText_ = upperValue;
+    }
+  }
+
+  Condition::Condition(LogicalOperation operation, const Vector< Condition >& operands):
+    Condition()
+  {
+    bool isUnary = operation == LOGICAL_NOT;
+    if ((operation == PREDICATE) || (isUnary && (operands.size() != 1)) || (!isUnary && (operands.size() < 2)))
+    {
+      throw std::invalid_argument("Invalid logical condition");
+    }
+    logicalOperation_ = operation;
+    operands_ = operands;
+  }
+
+  LogicalOperation Condition::getLogicalOperation() const noexcept
+  {
+    return logicalOperation_;
+  }
+
+  bool Condition::isCompound() const noexcept
+  {
+    return logicalOperation_ != PREDICATE;
+  }
+
+  const Vector< Condition >& Condition::getOperands() const noexcept
+  {
+    return operands_;
+  }
+
+  size_t Condition::getColumnIndex() const noexcept
+  {
+    return columnIndex_;
+  }
+
+  DataType Condition::getDataType() const noexcept
+  {
+    return dataType_;
+  }
+
+  CompareOperation Condition::getOperation() const noexcept
+  {
+    return operation_;
+  }
+
+  long long Condition::getInteger() const noexcept
+  {
+    return integer_;
+  }
+
+  double Condition::getReal() const noexcept
+  {
+    return real_;
+  }
+
+  const std::string& Condition::getText() const noexcept
+  {
+    return text_;
+  }
+
+  long long Condition::getUpperInteger() const noexcept
+  {
+    return upperInteger_;
+  }
+
+  double Condition::getUpperReal() const noexcept
+  {
+    return upperReal_;
+  }
+
+  const std::string& Condition::getUpperText() const noexcept
+  {
+    return upperText_;
+  }
+
+  bool Condition::isPlanned() const noexcept
+  {
+    return isPlanned_;
+  }
+
+  void Condition::setPlanned() noexcept
+  {
+    isPlanned_ = true;
+  }
+
+  void Condition::setParameters(size_t parameter, size_t upperParameter) noexcept
+  {
+    parameter_ = parameter;
+    upperParameter_ = upperParameter;
+  }
+
+  void Condition::bind(const Vector< std::string >& arguments)
+  {
+    for (size_t i = 0; i < operands_.size(); ++i)
+    {
+      operands_[i].bind(arguments);
+    }
+    if (parameter_ != NO_PARAMETER)
+    {
+      setValue(arguments[parameter_], integer_, real_, text_);
+      if (operation_ != BETWEEN)
+      {
+        upperInteger_ = integer_;
+        upperReal_ = real_;
+      }
+    }
+    if (upperParameter_ != NO_PARAMETER)
+    {
+      setValue(arguments[upperParameter_], upperInteger_, upperReal_, upperText_);
+    }
+  }
+
+  void Condition::setValue(const std::string& value, long long& integer, double& real, std::string& text) const
+  {
+    ParseStatus status = PARSE_OK;
+    if (dataType_ == TEXT)
+    {
+      text = value;
+    }
+    else if (dataType_ == REAL)
+    {
+      status = parseReal(value, real);
+    }
+    else
+    {
+      status = parseInteger(value, dataType_, integer);
+    }
+    if (status != PARSE_OK)
+    {
+      throw std::invalid_argument("Invalid value");
+    }
+  }
+}
@@ -0,0 +1,118 @@
+#ifndef CONDITION_HPP
+#define CONDITION_HPP
+#include <string>
+#include <string_view>
+
+#include "data_types.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  const size_t NO_PARAMETER = static_cast< size_t >(-1);
+
+  enum CompareOperation
+  {
+    EQUAL,
+    LESS,
+    LESS_EQUAL,
+    GREATER,
+    GREATER_EQUAL,
+    BETWEEN
+  };
+
+  enum LogicalOperation
+  {
+    PREDICATE,
+    LOGICAL_AND,
+    LOGICAL_OR,
+    LOGICAL_NOT
+  };
+
+  class Condition
+  {
+  public:
+    Condition();
+    Condition(size_t columnIndex, DataType dataType, const std::string& value);
+    Condition(size_t columnIndex, DataType dataType, CompareOperation operation,
+      const std::string& value, const std::string& upperValue = std::string());
+    Condition(LogicalOperation operation, const Vector< Condition >& operands);
+
+    LogicalOperation getLogicalOperation() const noexcept;
+    bool isCompound() const noexcept;
+    const Vector< Condition >& getOperands() const noexcept;
+    size_t getColumnIndex() const noexcept;
+    DataType getDataType() const noexcept;
+    CompareOperation getOperation() const noexcept;
+    long long getInteger() const noexcept;
+    double getReal() const noexcept;
+    const std::string& getText() const noexcept;
+    long long getUpperInteger() const noexcept;
+    double getUpperReal() const noexcept;
+    const std::string& getUpperText() const noexcept;
+    bool isPlanned() const noexcept;
+    void setPlanned() noexcept;
+    void setParameters(size_t parameter, size_t upperParameter) noexcept;
+    void bind(const Vector< std::string >& arguments);
+
+    template< class T >
+    bool isMatch(const T& value, const T& lower, const T& upper) const noexcept;
+    bool isMatch(long long value) const noexcept;
+    bool isMatch(double value) const noexcept;
+    bool isMatch(std::string_view value) const noexcept;
+
+  private:
+    LogicalOperation logicalOperation_;
+    Vector< Condition > operands_;
+    size_t columnIndex_;
+    DataType dataType_;
+    CompareOperation operation_;
+    long long integer_;
+    double real_;
+    std::string text_;
+    long long upperInteger_;
+    double upperReal_;
+    std::string upperText_;
+    size_t parameter_;
+    size_t upperParameter_;
+    bool isPlanned_;
+
+    void setValue(const std::string& value, long long& integer, double& real, std::string& text) const;
+  };
+
+  template< class T >
+  bool Condition::isMatch(const T& value, const T& lower, const T& upper) const noexcept
+  {
+    switch (operation_)
+    {
+    case EQUAL:
+      return value == lower;
+    case LESS:
+      return value < lower;
+    case LESS_EQUAL:
+      return value <= lower;
+    case GREATER:
+      return value > lower;
+    case GREATER_EQUAL:
+      return value >= lower;
+    default:
+      return (lower <= value) && (value <= upper);
+    }
+  }
+
+  inline bool Condition::isMatch(long long value) const noexcept
+  {
+    return isMatch(value, integer_, upperInteger_);
+  }
+
+  inline bool Condition::isMatch(double value) const noexcept
+  {
+    return isMatch(value, real_, upperReal_);
+  }
+
+  inline bool Condition::isMatch(std::string_view value) const noexcept
+  {
+    return isMatch(value, std::string_view(text_), std::string_view(upperText_));
+  }
+}
+
+#endif
@@ -0,0 +1,31 @@
+#ifndef DATA_TYPES_HPP
+#define DATA_TYPES_HPP
+#include <string>
+#include "hash_table.hpp"
+
+namespace babinov
+{
+  enum DataType
+  {
+    PK,
+    INTEGER,
+    REAL,
+    TEXT
+  };
+
+  const HashTable< DataType, std::string > DATA_TYPES_AS_STR = {
+    {PK, "PK"},
+    {INTEGER, "INTEGER"},
+    {REAL, "REAL"},
+    {TEXT, "TEXT"}
+  };
+
+  const HashTable< std::string, DataType > DATA_TYPES_FROM_STR = {
+    {"PK", PK},
+    {"INTEGER", INTEGER},
+    {"REAL", REAL},
+    {"TEXT", TEXT}
+  };
+}
+
+#endif
@@ -0,0 +1,302 @@
+#include "external_sort.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
+
+#include "vector.hpp"
+
+const size_t RUN_BUFFER_SIZE = 4096;
+
+std::atomic< size_t > sortMemoryLimit(babinov::DEFAULT_SORT_MEMORY_LIMIT);
+
+template< class Key >
+bool isKeyLess(const Key& lhs, const Key& rhs) noexcept
+{
+  return lhs < rhs;
+}
+
+template<>
+bool isKeyLess< double >(const double& lhs, const double& rhs) noexcept
+{
+  return (lhs < rhs) || (!std::isnan(lhs) && std::isnan(rhs));
+}
+
+template< class Key >
+struct SortEntry
+{
+  Key key;
+  size_t slot;
+};
+
+template< class Key >
+struct EntryLess
+{
+  bool isDescending;
+
+  bool operator()(const SortEntry< Key >& lhs, const SortEntry< Key >& rhs) const noexcept
+  {
+    if (isKeyLess(lhs.key, rhs.key))
+    {
+      return !isDescending;
+    }
+    if (isKeyLess(rhs.key, lhs.key))
+    {
+      return isDescending;
+    }
+    return lhs.slot < rhs.slot;
+  }
+};
+
+struct FileCloser
+{
+  void operator()(std::FILE* file) const noexcept
+  {
+    std::fclose(file);
+  }
+};
+
+using TempFile = std::unique_ptr< std::FILE, FileCloser >;
+
+class RunReader
+{
+public:
+  explicit RunReader(std::FILE* file):
+    file_(file),
+    buffer_(),
+    pos_(0),
+    size_(0)
+  {
+    std::rewind(file_);
+    buffer_.reserve(RUN_BUFFER_SIZE);
+    for (size_t i = 0; i < RUN_BUFFER_SIZE; ++i)
+    {
+      buffer_.pushBack(0);
+    }
+    fill();
+  }
+
+  bool isEmpty() const noexcept
+  {
+    return pos_ == size_;
+  }
+
+  size_t front() const noexcept
+  {
+    return buffer_[pos_];
+  }
+
+  void pop()
+  {
+    if (++pos_ == size_)
+    {
+      fill();
+    }
+  }
+
+private:
+  std::FILE* file_;
+  babinov::Vector< size_t > buffer_;
+  size_t pos_;
+  size_t size_;
+
+  void fill()
+  {
+    pos_ = 0;
+    size_ = std::fread(buffer_.data(), sizeof(size_t), RUN_BUFFER_SIZE, file_);
+  }
+};
+
+template< class Key >
+void writeRun(const babinov::Vector< SortEntry< Key > >& entries, babinov::Vector< TempFile >& runs)
+{
+  TempFile file(std::tmpfile());
+  if (!file)
+  {
+    throw babinov::SortError("Cannot create temporary file");
+  }
+  size_t buffer[RUN_BUFFER_SIZE];
+  for (size_t i = 0; i < entries.size(); i += RUN_BUFFER_SIZE)
+  {
+    size_t count = std::min(RUN_BUFFER_SIZE, entries.size() - i);
+    for (size_t j = 0; j < count; ++j)
+    {
+      buffer[j] = entries[i + j].slot;
+    }
+    if (std::fwrite(buffer, sizeof(size_t), count, file.get()) != count)
+    {
+      throw babinov::SortError("Cannot write temporary file");
+    }
+  }
+  if (std::fflush(file.get()))
+  {
+    throw babinov::SortError("Cannot write temporary file");
+  }
+  runs.pushBack(std::move(file));
+}
+
+template< class Key >
+void emitSorted(babinov::Vector< SortEntry< Key > >& entries, EntryLess< Key > less, size_t limit,
+  const babinov::SlotVisitor& visitor)
+{
+  std::sort(entries.data(), entries.data() + entries.size(), less);
+  size_t count = limit ? std::min(limit, entries.size()) : entries.size();
+  for (size_t i = 0; i < count; ++i)
+  {
+    if (!visitor(entries[i].slot))
+    {
+      return;
+    }
+  }
+}
+
+template< class Key, class Getter >
+void mergeRuns(babinov::Vector< TempFile >& runs, Getter getKey, EntryLess< Key > less, size_t limit,
+  const babinov::SlotVisitor& visitor)
+{
+  babinov::Vector< RunReader > readers;
+  readers.reserve(runs.size());
+  for (size_t i = 0; i < runs.size(); ++i)
+  {
+    readers.pushBack(RunReader(runs[i].get()));
+  }
+  babinov::Vector< SortEntry< size_t > > heads;
+  auto headKey = [&](const SortEntry< size_t >& head)
+  {
+    return SortEntry< Key >{ getKey(head.slot), head.slot };
+  };
+  auto isAfter = [&](const SortEntry< size_t >& lhs, const SortEntry< size_t >& rhs)
+  {
+    return less(headKey(rhs), headKey(lhs));
+  };
+  for (size_t i = 0; i < readers.size(); ++i)
+  {
+    if (!readers[i].isEmpty())
+    {
+      heads.pushBack(SortEntry< size_t >{ i, readers[i].front() });
+    }
+  }
+  std::make_heap(heads.data(), heads.data() + heads.size(), isAfter);
+  for (size_t nEmitted = 0; !heads.isEmpty() && (!limit || (nEmitted < limit)); ++nEmitted)
+  {
+    std::pop_heap(heads.data(), heads.data() + heads.size(), isAfter);
+    SortEntry< size_t >& head = heads[heads.size() - 1];
+    if (!visitor(head.slot))
+    {
+      return;
+    }
+    RunReader& reader = readers[head.key];
+    reader.pop();
+    if (reader.isEmpty())
+    {
+      heads.popBack();
+      continue;
+    }
+    head.slot = reader.front();
+    std::push_heap(heads.data(), heads.data() + heads.size(), isAfter);
+  }
+}
+
+template< class Key, class Getter >
+void sortTyped(Getter getKey, bool isDescending, size_t limit, const babinov::SlotSource& source,
+  const babinov::SlotVisitor& visitor)
+{
+  EntryLess< Key > less{ isDescending };
+  size_t maxEntries = std::max< size_t >(babinov::getSortMemoryLimit() / sizeof(SortEntry< Key >), 1);
+  babinov::Vector< SortEntry< Key > > entries;
+  if (limit && (limit <= maxEntries))
+  {
+    entries.reserve(limit);
+    source([&](size_t slot)
+    {
+      SortEntry< Key > entry{ getKey(slot), slot };
+      if (entries.size() < limit)
+      {
+        entries.pushBack(entry);
+        std::push_heap(entries.data(), entries.data() + entries.size(), less);
+      }
+      else if (less(entry, entries[0]))
+      {
+        std::pop_heap(entries.data(), entries.data() + entries.size(), less);
+        entries[entries.size() - 1] = entry;
+        std::push_heap(entries.data(), entries.data() + entries.size(), less);
+      }
+      return true;
+    });
+    emitSorted(entries, less, limit, visitor);
+    return;
+  }
+  babinov::Vector< TempFile > runs;
+  source([&](size_t slot)
+  {
+    if (entries.size() == maxEntries)
+    {
+      std::sort(entries.data(), entries.data() + entries.size(), less);
+      writeRun(entries, runs);
+      entries.clear();
+    }
+    entries.pushBack(SortEntry< Key >{ getKey(slot), slot });
+    return true;
+  });
+  if (runs.isEmpty())
+  {
+    emitSorted(entries, less, limit, visitor);
+    return;
+  }
+  if (!entries.isEmpty())
+  {
+    std::sort(entries.data(), entries.data() + entries.size(), less);
+    writeRun(entries, runs);
+  }
+  babinov::Vector< SortEntry< Key > >().swap(entries);
+  mergeRuns< Key >(runs, getKey, less, limit, visitor);
+}
+
+namespace babinov
+{
+  void setSortMemoryLimit(size_t bytes)
+  {
+    if (!bytes)
+    {
+      throw std::invalid_argument("Invalid sort memory limit");
+    }
+    sortMemoryLimit = bytes;
+  }
+
+  size_t getSortMemoryLimit() noexcept
+  {
+    return sortMemoryLimit;
+  }
+
+  void sortSlots(const ColumnStore& column, bool isDescending, size_t limit, const SlotSource& source,
+    const SlotVisitor& visitor)
+  {
+    if (column.getDataType() == TEXT)
+    {
+      auto getKey = [&column](size_t slot)
+      {
+        return column.getText(slot);
+      };
+      sortTyped< std::string_view >(getKey, isDescending, limit, source, visitor);
+    }
+    else if (column.getDataType() == REAL)
+    {
+      auto getKey = [&column](size_t slot)
+      {
+        return column.getReal(slot);
+      };
+      sortTyped< double >(getKey, isDescending, limit, source, visitor);
+    }
+    else
+    {
+      auto getKey = [&column](size_t slot)
+      {
+        return column.getInteger(slot);
+      };
+      sortTyped< long long >(getKey, isDescending, limit, source, visitor);
+    }
+  }
+}
@@ -0,0 +1,27 @@
+#ifndef EXTERNAL_SORT_HPP
+#define EXTERNAL_SORT_HPP
+#include <functional>
+#include <stdexcept>
+
+#include "column_store.hpp"
+
+namespace babinov
+{
+  const size_t DEFAULT_SORT_MEMORY_LIMIT = 64 << 20;
+
+  class SortError: public std::runtime_error
+  {
+  public:
+    using std::runtime_error::runtime_error;
+  };
+
+  using SlotVisitor = std::function< bool(size_t) >;
+  using SlotSource = std::function< void(const SlotVisitor&) >;
+
+  void setSortMemoryLimit(size_t bytes);
+  size_t getSortMemoryLimit() noexcept;
+  void sortSlots(const ColumnStore& column, bool isDescending, size_t limit, const SlotSource& source,
+    const SlotVisitor& visitor);
+}
+
+#endif
@@ -0,0 +1,97 @@
+#include "hash_index.hpp"
+#include <cstring>
+#include <string>
+
+namespace babinov
+{
+  HashIndex::HashIndex(DataType dataType):
+    dataType_(dataType),
+    numbers_(),
+    texts_()
+  {}
+
+  DataType HashIndex::getDataType() const noexcept
+  {
+    return dataType_;
+  }
+
+  const Vector< size_t >* HashIndex::find(const Condition& condition) const
+  {
+    if (dataType_ == TEXT)
+    {
+      auto desired = texts_.find(condition.getText());
+      return (desired != texts_.cend()) ? &(*desired).second.getIds() : nullptr;
+    }
+    long long key = condition.getInteger();
+    if (dataType_ == REAL)
+    {
+      if (condition.getReal() != condition.getReal())
+      {
+        return nullptr;
+      }
+      key = getRealKey(condition.getReal());
+    }
+    auto desired = numbers_.find(key);
+    return (desired != numbers_.cend()) ? &(*desired).second.getIds() : nullptr;
+  }
+
+  void HashIndex::insert(const ColumnStore& column, size_t slot, size_t id)
+  {
+    if (dataType_ == TEXT)
+    {
+      texts_[std::string(column.getText(slot))].insert(id);
+    }
+    else if (dataType_ == REAL)
+    {
+      numbers_[getRealKey(column.getReal(slot))].insert(id);
+    }
+    else
+    {
+      numbers_[column.getInteger(slot)].insert(id);
+    }
+  }
+
+  void HashIndex::erase(const ColumnStore& column, size_t slot, size_t id)
+  {
+    if (dataType_ == TEXT)
+    {
+      auto desired = texts_.find(std::string(column.getText(slot)));
+      if (desired != texts_.end())
+      {
+        (*desired).second.erase(id);
+        if ((*desired).second.isEmpty())
+        {
+          texts_.erase(desired);
+        }
+      }
+      return;
+    }
+    long long key = (dataType_ == REAL) ? getRealKey(column.getReal(slot)) : column.getInteger(slot);
+    auto desired = numbers_.find(key);
+    if (desired != numbers_.end())
+    {
+      (*desired).second.erase(id);
+      if ((*desired).second.isEmpty())
+      {
+        numbers_.erase(desired);
+      }
+    }
+  }
+
+  void HashIndex::clear() noexcept
+  {
+    numbers_.clear();
+    texts_.clear();
+  }
+
+  long long HashIndex::getRealKey(double value) noexcept
+  {
+    if (value == 0.0)
+    {
+      value = 0.0;
+    }
+    long long key = 0;
+    std::memcpy(&key, &value, sizeof(key));
+    return key;
+  }
+}
@@ -0,0 +1,35 @@
+#ifndef HASH_INDEX_HPP
+#define HASH_INDEX_HPP
+#include <string>
+
+#include "column_store.hpp"
+#include "condition.hpp"
+#include "data_types.hpp"
+#include "hash_policies.hpp"
+#include "row_id_set.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  class HashIndex
+  {
+  public:
+    explicit HashIndex(DataType dataType = PK);
+
+    DataType getDataType() const noexcept;
+    const Vector< size_t >* find(const Condition& condition) const;
+
+    void insert(const ColumnStore& column, size_t slot, size_t id);
+    void erase(const ColumnStore& column, size_t slot, size_t id);
+    void clear() noexcept;
+
+  private:
+    DataType dataType_;
+    HashMap< long long, RowIdSet > numbers_;
+    HashMap< std::string, RowIdSet > texts_;
+
+    static long long getRealKey(double value) noexcept;
+  };
+}
+
+#endif
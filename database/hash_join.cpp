@@ -0,0 +1,237 @@
+#include "hash_join.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include "column_store.hpp"
+#include "hash_policies.hpp"
+#include "vector.hpp"
+
+const size_t JOIN_CACHE_SIZE = 1 << 18;
+const size_t MAX_PARTITION_BITS = 12;
+
+babinov::Vector< size_t > collectAliveSlots(const babinov::Table& table)
+{
+  babinov::Vector< size_t > slots;
+  slots.reserve(table.size());
+  table.forEach([&slots](const babinov::Table::RowRef& row)
+  {
+    slots.pushBack(row.getSlot());
+    return true;
+  });
+  return slots;
+}
+
+bool isIntegerType(babinov::DataType dataType) noexcept
+{
+  return (dataType == babinov::PK) || (dataType == babinov::INTEGER);
+}
+
+template< class Key >
+size_t getPartition(const Key& key, size_t nBits) noexcept
+{
+  if (!nBits)
+  {
+    return 0;
+  }
+  std::uint64_t hash = static_cast< std::uint64_t >(std::hash< Key >()(key)) * 0x9E3779B97F4A7C15ULL;
+  return static_cast< size_t >(hash >> (64 - nBits));
+}
+
+template< class Key >
+size_t getPartitionBits(size_t nBuild) noexcept
+{
+  size_t bytes = nBuild * (sizeof(std::pair< const Key, size_t >) + sizeof(size_t)) / 7 * 8;
+  size_t nBits = 0;
+  while (((bytes >> nBits) > JOIN_CACHE_SIZE) && (nBits < MAX_PARTITION_BITS))
+  {
+    ++nBits;
+  }
+  return nBits;
+}
+
+template< class Key, class Getter >
+void partitionSlots(const babinov::Vector< size_t >& slots, Getter getKey, size_t nBits,
+  babinov::Vector< size_t >& offsets, babinov::Vector< size_t >& dest)
+{
+  size_t nPartitions = size_t(1) << nBits;
+  offsets.clear();
+  for (size_t i = 0; i <= nPartitions; ++i)
+  {
+    offsets.pushBack(0);
+  }
+  babinov::Vector< size_t > partitions;
+  partitions.reserve(slots.size());
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    size_t partition = getPartition< Key >(getKey(slots[i]), nBits);
+    partitions.pushBack(partition);
+    ++offsets[partition + 1];
+  }
+  for (size_t i = 0; i < nPartitions; ++i)
+  {
+    offsets[i + 1] += offsets[i];
+  }
+  babinov::Vector< size_t > positions(offsets);
+  dest.clear();
+  dest.reserve(slots.size());
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    dest.pushBack(0);
+  }
+  for (size_t i = 0; i < slots.size(); ++i)
+  {
+    dest[positions[partitions[i]]++] = slots[i];
+  }
+}
+
+template< class Key, class BuildGetter, class ProbeGetter, class Emit >
+bool joinPartition(const size_t* build, size_t nBuild, BuildGetter buildKey, const size_t* probe, size_t nProbe,
+  ProbeGetter probeKey, Emit emit)
+{
+  if (!nBuild || !nProbe)
+  {
+    return true;
+  }
+  babinov::HashMap< Key, size_t > heads;
+  heads.rehash(nBuild + nBuild / 7 + 1);
+  babinov::Vector< size_t > next;
+  next.reserve(nBuild);
+  for (size_t i = 0; i < nBuild; ++i)
+  {
+    next.pushBack(nBuild);
+  }
+  for (size_t i = nBuild; i-- > 0;)
+  {
+    auto inserted = heads.insert(buildKey(build[i]), i);
+    if (!inserted.second)
+    {
+      next[i] = (*inserted.first).second;
+      (*inserted.first).second = i;
+    }
+  }
+  for (size_t j = 0; j < nProbe; ++j)
+  {
+    auto desired = heads.find(probeKey(probe[j]));
+    if (desired == heads.end())
+    {
+      continue;
+    }
+    for (size_t i = (*desired).second; i != nBuild; i = next[i])
+    {
+      if (!emit(build[i], probe[j]))
+      {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template< class Key, class BuildGetter, class ProbeGetter, class Emit >
+void joinSides(const babinov::Vector< size_t >& build, BuildGetter buildKey, const babinov::Vector< size_t >& probe,
+  ProbeGetter probeKey, Emit emit, babinov::JoinMode mode)
+{
+  size_t nBits = (mode == babinov::HASH_JOIN) ? 0 : getPartitionBits< Key >(build.size());
+  if ((mode == babinov::RADIX_JOIN) && !nBits)
+  {
+    nBits = 1;
+  }
+  if (!nBits)
+  {
+    joinPartition< Key >(build.data(), build.size(), buildKey, probe.data(), probe.size(), probeKey, emit);
+    return;
+  }
+  babinov::Vector< size_t > buildOffsets;
+  babinov::Vector< size_t > buildParts;
+  babinov::Vector< size_t > probeOffsets;
+  babinov::Vector< size_t > probeParts;
+  partitionSlots< Key >(build, buildKey, nBits, buildOffsets, buildParts);
+  partitionSlots< Key >(probe, probeKey, nBits, probeOffsets, probeParts);
+  for (size_t i = 0; i + 1 < buildOffsets.size(); ++i)
+  {
+    const size_t* buildPart = buildParts.data() + buildOffsets[i];
+    const size_t* probePart = probeParts.data() + probeOffsets[i];
+    size_t nBuild = buildOffsets[i + 1] - buildOffsets[i];
+    size_t nProbe = probeOffsets[i + 1] - probeOffsets[i];
+    if (!joinPartition< Key >(buildPart, nBuild, buildKey, probePart, nProbe, probeKey, emit))
+    {
+      return;
+    }
+  }
+}
+
+template< class Key, class LeftGetter, class RightGetter >
+void joinTables(const babinov::Table& left, LeftGetter leftKey, const babinov::Table& right, RightGetter rightKey,
+  const babinov::JoinVisitor& visitor, babinov::JoinMode mode)
+{
+  using babinov::Table;
+  babinov::Vector< size_t > leftSlots = collectAliveSlots(left);
+  babinov::Vector< size_t > rightSlots = collectAliveSlots(right);
+  if (leftSlots.size() > rightSlots.size())
+  {
+    auto emit = [&](size_t buildSlot, size_t probeSlot)
+    {
+      return visitor(Table::RowRef(left, probeSlot), Table::RowRef(right, buildSlot));
+    };
+    joinSides< Key >(rightSlots, rightKey, leftSlots, leftKey, emit, mode);
+    return;
+  }
+  auto emit = [&](size_t buildSlot, size_t probeSlot)
+  {
+    return visitor(Table::RowRef(left, buildSlot), Table::RowRef(right, probeSlot));
+  };
+  joinSides< Key >(leftSlots, leftKey, rightSlots, rightKey, emit, mode);
+}
+
+namespace babinov
+{
+  void hashJoin(const Table& left, const std::string& leftColumn, const Table& right, const std::string& rightColumn,
+    const JoinVisitor& visitor, JoinMode mode)
+  {
+    const ColumnStore& leftData = left.getColumnData(left.getColumnIndex(leftColumn));
+    const ColumnStore& rightData = right.getColumnData(right.getColumnIndex(rightColumn));
+    DataType leftType = leftData.getDataType();
+    DataType rightType = rightData.getDataType();
+    if (isIntegerType(leftType) && isIntegerType(rightType))
+    {
+      auto leftKey = [&leftData](size_t slot)
+      {
+        return leftData.getInteger(slot);
+      };
+      auto rightKey = [&rightData](size_t slot)
+      {
+        return rightData.getInteger(slot);
+      };
+      joinTables< long long >(left, leftKey, right, rightKey, visitor, mode);
+    }
+    else if ((leftType == REAL) && (rightType == REAL))
+    {
+      auto leftKey = [&leftData](size_t slot)
+      {
+        return leftData.getReal(slot);
+      };
+      auto rightKey = [&rightData](size_t slot)
+      {
+        return rightData.getReal(slot);
+      };
+      joinTables< double >(left, leftKey, right, rightKey, visitor, mode);
+    }
+    else if ((leftType == TEXT) && (rightType == TEXT))
+    {
+      auto leftKey = [&leftData](size_t slot)
+      {
+        return leftData.getText(slot);
+      };
+      auto rightKey = [&rightData](size_t slot)
+      {
+        return rightData.getText(slot);
+      };
+      joinTables< std::string_view >(left, leftKey, right, rightKey, visitor, mode);
+    }
+    else
+    {
+      throw std::invalid_argument("Incompatible join columns");
+    }
+  }
+}
@@ -0,0 +1,23 @@
+#ifndef HASH_JOIN_HPP
+#define HASH_JOIN_HPP
+#include <functional>
+#include <string>
+
+#include "tables.hpp"
+
+namespace babinov
+{
+  enum JoinMode
+  {
+    AUTO_JOIN,
+    HASH_JOIN,
+    RADIX_JOIN
+  };
+
+  using JoinVisitor = std::function< bool(const Table::RowRef&, const Table::RowRef&) >;
+
+  void hashJoin(const Table& left, const std::string& leftColumn, const Table& right, const std::string& rightColumn,
+    const JoinVisitor& visitor, JoinMode mode = AUTO_JOIN);
+}
+
+#endif
@@ -0,0 +1,108 @@
+#include "id_directory.hpp"
+
+namespace babinov
+{
+  IdDirectory::IdDirectory():
+    pages_(),
+    sparse_(),
+    size_(0)
+  {}
+
+  size_t IdDirectory::size() const noexcept
+  {
+    return size_;
+  }
+
+  size_t IdDirectory::find(size_t id) const noexcept
+  {
+    size_t page = id >> PAGE_BITS_;
+    if ((page < pages_.size()) && !pages_[page].isEmpty())
+    {
+      size_t slot = pages_[page][id & (PAGE_SIZE_ - 1)];
+      if ((slot != NO_SLOT) || sparse_.isEmpty())
+      {
+        return slot;
+      }
+    }
+    if (sparse_.isEmpty())
+    {
+      return NO_SLOT;
+    }
+    auto desired = sparse_.find(id);
+    return (desired != sparse_.cend()) ? (*desired).second : NO_SLOT;
+  }
+
+  void IdDirectory::insert(size_t id, size_t slot)
+  {
+    if (!isDense(id))
+    {
+      auto inserted = sparse_.insert(id, slot);
+      if (inserted.second)
+      {
+        ++size_;
+      }
+      else
+      {
+        (*inserted.first).second = slot;
+      }
+      return;
+    }
+    size_t page = id >> PAGE_BITS_;
+    while (pages_.size() <= page)
+    {
+      pages_.pushBack(Vector< size_t >());
+    }
+    Vector< size_t >& entries = pages_[page];
+    if (entries.isEmpty())
+    {
+      entries.reserve(PAGE_SIZE_);
+      for (size_t i = 0; i < PAGE_SIZE_; ++i)
+      {
+        entries.pushBack(NO_SLOT);
+      }
+    }
+    size_t& entry = entries[id & (PAGE_SIZE_ - 1)];
+    if ((entry == NO_SLOT) && (sparse_.isEmpty() || !sparse_.erase(id)))
+    {
+      ++size_;
+    }
+    entry = slot;
+  }
+
+  void IdDirectory::erase(size_t id)
+  {
+    size_t* entry = findEntry(id);
+    if (entry)
+    {
+      *entry = NO_SLOT;
+      --size_;
+    }
+    else if (!sparse_.isEmpty() && sparse_.erase(id))
+    {
+      --size_;
+    }
+  }
+
+  void IdDirectory::clear() noexcept
+  {
+    pages_.clear();
+    sparse_.clear();
+    size_ = 0;
+  }
+
+  bool IdDirectory::isDense(size_t id) const noexcept
+  {
+    return ((id >> PAGE_BITS_) < pages_.size()) || (id < DENSITY_FACTOR_ * (size_ + PAGE_SIZE_));
+  }
+
+  size_t* IdDirectory::findEntry(size_t id) noexcept
+  {
+    size_t page = id >> PAGE_BITS_;
+    if ((page >= pages_.size()) || pages_[page].isEmpty())
+    {
+      return nullptr;
+    }
+    size_t& entry = pages_[page][id & (PAGE_SIZE_ - 1)];
+    return (entry != NO_SLOT) ? &entry : nullptr;
+  }
+}
@@ -0,0 +1,38 @@
+#ifndef ID_DIRECTORY_HPP
+#define ID_DIRECTORY_HPP
+#include <cstddef>
+
+#include "hash_policies.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  const size_t NO_SLOT = static_cast< size_t >(-1);
+
+  class IdDirectory
+  {
+  public:
+    IdDirectory();
+
+    size_t size() const noexcept;
+    size_t find(size_t id) const noexcept;
+
+    void insert(size_t id, size_t slot);
+    void erase(size_t id);
+    void clear() noexcept;
+
+  private:
+    static const size_t PAGE_BITS_ = 12;
+    static const size_t PAGE_SIZE_ = size_t(1) << PAGE_BITS_;
+    static const size_t DENSITY_FACTOR_ = 4;
+
+    Vector< Vector< size_t > > pages_;
+    HashMap< size_t, size_t > sparse_;
+    size_t size_;
+
+    bool isDense(size_t id) const noexcept;
+    size_t* findEntry(size_t id) noexcept;
+  };
+}
+
+#endif
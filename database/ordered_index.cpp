@@ -0,0 +1,118 @@
+#include "ordered_index.hpp"
+#include <string>
+
+namespace babinov
+{
+  OrderedIndex::OrderedIndex(DataType dataType):
+    dataType_(dataType),
+    integers_(),
+    reals_(),
+    texts_()
+  {}
+
+  DataType OrderedIndex::getDataType() const noexcept
+  {
+    return dataType_;
+  }
+
+  void OrderedIndex::collect(const Condition& condition, Vector< size_t >& ids) const
+  {
+    if (dataType_ == TEXT)
+    {
+      collect(texts_, condition, condition.getText(), condition.getUpperText(), ids);
+    }
+    else if (dataType_ == REAL)
+    {
+      collect(reals_, condition, condition.getReal(), condition.getUpperReal(), ids);
+    }
+    else
+    {
+      collect(integers_, condition, condition.getInteger(), condition.getUpperInteger(), ids);
+    }
+  }
+
+  void OrderedIndex::insert(const ColumnStore& column, size_t slot, size_t id)
+  {
+    if (dataType_ == TEXT)
+    {
+      texts_[std::string(column.getText(slot))].insert(id);
+    }
+    else if (dataType_ == REAL)
+    {
+      double value = column.getReal(slot);
+      if (value == value)
+      {
+        reals_[value].insert(id);
+      }
+    }
+    else
+    {
+      integers_[column.getInteger(slot)].insert(id);
+    }
+  }
+
+  void OrderedIndex::erase(const ColumnStore& column, size_t slot, size_t id)
+  {
+    if (dataType_ == TEXT)
+    {
+      erase(texts_, std::string(column.getText(slot)), id);
+    }
+    else if (dataType_ == REAL)
+    {
+      double value = column.getReal(slot);
+      if (value == value)
+      {
+        erase(reals_, value, id);
+      }
+    }
+    else
+    {
+      erase(integers_, column.getInteger(slot), id);
+    }
+  }
+
+  void OrderedIndex::clear() noexcept
+  {
+    integers_.clear();
+    reals_.clear();
+    texts_.clear();
+  }
+
+  template< class T >
+  void OrderedIndex::collect(const BPlusTree< T, RowIdSet >& tree, const Condition& condition,
+    const T& lower, const T& upper, Vector< size_t >& ids)
+  {
+    CompareOperation operation = condition.getOperation();
+    auto it = tree.lowerBound(lower);
+    if ((operation == LESS) || (operation == LESS_EQUAL))
+    {
+      it = tree.cbegin();
+    }
+    else if (operation == GREATER)
+    {
+      it = tree.upperBound(lower);
+    }
+    for (; (it != tree.cend()) && condition.isMatch((*it).first, lower, upper); ++it)
+    {
+      const Vector< size_t >& keyIds = (*it).second.getIds();
+      for (size_t i = 0; i < keyIds.size(); ++i)
+      {
+        ids.pushBack(keyIds[i]);
+      }
+    }
+  }
+
+  template< class T >
+  void OrderedIndex::erase(BPlusTree< T, RowIdSet >& tree, const T& key, size_t id)
+  {
+    auto desired = tree.find(key);
+    if (desired != tree.end())
+    {
+      (*desired).second.erase(id);
+      if ((*desired).second.isEmpty())
+      {
+        tree.erase(key);
+      }
+    }
+  }
+}
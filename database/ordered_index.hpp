@@ -0,0 +1,40 @@
+#ifndef ORDERED_INDEX_HPP
+#define ORDERED_INDEX_HPP
+#include <string>
+
+#include "b_plus_tree.hpp"
+#include "column_store.hpp"
+#include "condition.hpp"
+#include "data_types.hpp"
+#include "row_id_set.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  class OrderedIndex
+  {
+  public:
+    explicit OrderedIndex(DataType dataType = PK);
+
+    DataType getDataType() const noexcept;
+    void collect(const Condition& condition, Vector< size_t >& ids) const;
+
+    void insert(const ColumnStore& column, size_t slot, size_t id);
+    void erase(const ColumnStore& column, size_t slot, size_t id);
+    void clear() noexcept;
+
+  private:
+    DataType dataType_;
+    BPlusTree< long long, RowIdSet > integers_;
+    BPlusTree< double, RowIdSet > reals_;
+    BPlusTree< std::string, RowIdSet > texts_;
+
+    template< class T >
+    static void collect(const BPlusTree< T, RowIdSet >& tree, const Condition& condition,
+      const T& lower, const T& upper, Vector< size_t >& ids);
+    template< class T >
+    static void erase(BPlusTree< T, RowIdSet >& tree, const T& key, size_t id);
+  };
+}
+
+#endif
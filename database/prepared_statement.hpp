@@ -0,0 +1,30 @@
+#ifndef PREPARED_STATEMENT_HPP
+#define PREPARED_STATEMENT_HPP
+#include <functional>
+#include <ostream>
+#include <string>
+
+#include "data_types.hpp"
+#include "hash_policies.hpp"
+#include "query_profile.hpp"
+#include "tables.hpp"
+#include "vector.hpp"
+#include "write_ahead_log.hpp"
+
+namespace babinov
+{
+  struct PreparedStatement
+  {
+    using Executor = std::function< void(Table&, WriteAheadLog*, const Vector< std::string >&, QueryProfile*,
+      std::ostream&) >;
+
+    std::string tableName;
+    Vector< Table::Column > columns;
+    Vector< DataType > parameters;
+    Executor execute;
+  };
+
+  using StatementMap = HashMap< std::string, PreparedStatement >;
+}
+
+#endif
@@ -0,0 +1,105 @@
+#include "query_profile.hpp"
+#include <cmath>
+
+const char* getAccessMethodName(babinov::AccessMethod method) noexcept
+{
+  switch (method)
+  {
+  case babinov::ID_LOOKUP:
+    return "ID LOOKUP";
+  case babinov::HASH_INDEX_LOOKUP:
+    return "HASH INDEX";
+  case babinov::ORDERED_INDEX_RANGE:
+    return "ORDERED INDEX";
+  case babinov::INDEX_UNION:
+    return "INDEX UNION";
+  default:
+    return "FULL SCAN";
+  }
+}
+
+namespace babinov
+{
+  QueryProfile::QueryProfile() noexcept:
+    isEnabled(false),
+    isRequested(false),
+    hasAccess(false),
+    hasPhases(false),
+    isOutputDiscarded(false),
+    access{ FULL_SCAN, 0, 0.0 },
+    accessColumn(),
+    actualRows(0),
+    parseMs(0.0),
+    scanMs(0.0),
+    materializeMs(0.0),
+    printMs(0.0),
+    totalMs(0.0)
+  {}
+
+  bool QueryProfile::isActive() const noexcept
+  {
+    return isEnabled || isRequested;
+  }
+
+  void QueryProfile::reset() noexcept
+  {
+    isRequested = false;
+    hasAccess = false;
+    hasPhases = false;
+    isOutputDiscarded = false;
+    access = Table::AccessPath{ FULL_SCAN, 0, 0.0 };
+    accessColumn.clear();
+    actualRows = 0;
+    parseMs = 0.0;
+    scanMs = 0.0;
+    materializeMs = 0.0;
+    printMs = 0.0;
+    totalMs = 0.0;
+  }
+
+  void QueryProfile::recordAccess(const Table& table, const Condition* condition)
+  {
+    hasAccess = true;
+    if (!condition)
+    {
+      access = Table::AccessPath{ FULL_SCAN, 0, static_cast< double >(table.size()) };
+      return;
+    }
+    access = table.explain(*condition);
+    if ((access.method != ID_LOOKUP) && (access.method != INDEX_UNION))
+    {
+      accessColumn = table.getColumns()[access.columnIndex].first;
+    }
+  }
+
+  double getElapsedMs(ProfileClock::time_point start) noexcept
+  {
+    return std::chrono::duration< double, std::milli >(ProfileClock::now() - start).count();
+  }
+
+  void printProfile(std::ostream& out, const QueryProfile& profile)
+  {
+    if (profile.hasAccess)
+    {
+      out << "<ACCESS: " << getAccessMethodName(profile.access.method);
+      if (!profile.accessColumn.empty())
+      {
+        out << " ON " << profile.accessColumn;
+      }
+      out << '>' << '\n';
+      out << "<ROWS: " << std::llround(profile.access.estimatedRows) << " ESTIMATED, ";
+      out << profile.actualRows << " ACTUAL>" << '\n';
+    }
+    out << "<TIME:";
+    if (profile.hasPhases)
+    {
+      out << " PARSE " << profile.parseMs << " MS, SCAN " << profile.scanMs << " MS, MATERIALIZE ";
+      out << profile.materializeMs << " MS,";
+      if (!profile.isOutputDiscarded)
+      {
+        out << " PRINT " << profile.printMs << " MS,";
+      }
+    }
+    out << " TOTAL " << profile.totalMs << " MS>" << '\n';
+  }
+}
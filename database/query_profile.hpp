@@ -0,0 +1,39 @@
+#ifndef QUERY_PROFILE_HPP
+#define QUERY_PROFILE_HPP
+#include <chrono>
+#include <ostream>
+#include <string>
+
+#include "tables.hpp"
+
+namespace babinov
+{
+  using ProfileClock = std::chrono::steady_clock;
+
+  struct QueryProfile
+  {
+    bool isEnabled;
+    bool isRequested;
+    bool hasAccess;
+    bool hasPhases;
+    bool isOutputDiscarded;
+    Table::AccessPath access;
+    std::string accessColumn;
+    size_t actualRows;
+    double parseMs;
+    double scanMs;
+    double materializeMs;
+    double printMs;
+    double totalMs;
+
+    QueryProfile() noexcept;
+    bool isActive() const noexcept;
+    void reset() noexcept;
+    void recordAccess(const Table& table, const Condition* condition);
+  };
+
+  double getElapsedMs(ProfileClock::time_point start) noexcept;
+  void printProfile(std::ostream& out, const QueryProfile& profile);
+}
+
+#endif
@@ -0,0 +1,77 @@
+#include "row_id_set.hpp"
+
+namespace babinov
+{
+  RowIdSet::RowIdSet():
+    ids_(),
+    positions_()
+  {}
+
+  size_t RowIdSet::size() const noexcept
+  {
+    return ids_.size();
+  }
+
+  bool RowIdSet::isEmpty() const noexcept
+  {
+    return ids_.isEmpty();
+  }
+
+  const Vector< size_t >& RowIdSet::getIds() const noexcept
+  {
+    return ids_;
+  }
+
+  void RowIdSet::insert(size_t id)
+  {
+    ids_.pushBack(id);
+    if (!positions_.isEmpty())
+    {
+      positions_.insert(id, ids_.size() - 1);
+    }
+    else if (ids_.size() == MIN_MAPPED_SIZE_)
+    {
+      for (size_t i = 0; i < ids_.size(); ++i)
+      {
+        positions_.insert(ids_[i], i);
+      }
+    }
+  }
+
+  void RowIdSet::erase(size_t id)
+  {
+    size_t pos = findPosition(id);
+    if (pos == ids_.size())
+    {
+      return;
+    }
+    size_t last = ids_[ids_.size() - 1];
+    ids_[pos] = last;
+    ids_.popBack();
+    if (!positions_.isEmpty())
+    {
+      positions_.erase(id);
+      if (last != id)
+      {
+        positions_[last] = pos;
+      }
+    }
+  }
+
+  size_t RowIdSet::findPosition(size_t id) const noexcept
+  {
+    if (positions_.isEmpty())
+    {
+      for (size_t i = 0; i < ids_.size(); ++i)
+      {
+        if (ids_[i] == id)
+        {
+          return i;
+        }
+      }
+      return ids_.size();
+    }
+    const size_t* pos = positions_.findValue(id);
+    return pos ? *pos : ids_.size();
+  }
+}
@@ -0,0 +1,32 @@
+#ifndef ROW_ID_SET_HPP
+#define ROW_ID_SET_HPP
+#include <cstddef>
+
+#include "hash_policies.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  class RowIdSet
+  {
+  public:
+    RowIdSet();
+
+    size_t size() const noexcept;
+    bool isEmpty() const noexcept;
+    const Vector< size_t >& getIds() const noexcept;
+
+    void insert(size_t id);
+    void erase(size_t id);
+
+  private:
+    static const size_t MIN_MAPPED_SIZE_ = 16;
+
+    Vector< size_t > ids_;
+    HashMap< size_t, size_t > positions_;
+
+    size_t findPosition(size_t id) const noexcept;
+  };
+}
+
+#endif
@@ -0,0 +1,407 @@
+#include "scan_kernels.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+#define SCAN_USE_X86
+#endif
+
+enum SimdLevel
+{
+  SIMD_SCALAR,
+  SIMD_SSE42,
+  SIMD_AVX2
+};
+
+SimdLevel detectSimdLevel() noexcept
+{
+#ifdef SCAN_USE_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+  {
+    return SIMD_AVX2;
+  }
+  if (__builtin_cpu_supports("sse4.2"))
+  {
+    return SIMD_SSE42;
+  }
+#endif
+  return SIMD_SCALAR;
+}
+
+SimdLevel getSimdLevel() noexcept
+{
+  static const SimdLevel level = detectSimdLevel();
+  return level;
+}
+
+template< class T >
+void selectRangeScalar(const T* values, size_t begin, size_t count, T lower, T upper, uint64_t* bitmap) noexcept
+{
+  for (size_t i = begin; i < count; ++i)
+  {
+    if ((values[i] >= lower) && (values[i] <= upper))
+    {
+      bitmap[i / 64] |= uint64_t(1) << (i % 64);
+    }
+  }
+}
+
+size_t countTrailingZeros(uint64_t word) noexcept
+{
+#ifdef __GNUC__
+  return __builtin_ctzll(word);
+#else
+  size_t count = 0;
+  while (!(word & 1))
+  {
+    word >>= 1;
+    ++count;
+  }
+  return count;
+#endif
+}
+
+size_t countBits(uint64_t word) noexcept
+{
+#ifdef __GNUC__
+  return __builtin_popcountll(word);
+#else
+  size_t count = 0;
+  for (; word; word &= word - 1)
+  {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+template< class T, class Visitor >
+void visitSelected(const T* values, const bool* isAlive, size_t begin, size_t end, T lower, T upper, Visitor visit)
+{
+  const size_t blockSize = 4096;
+  uint64_t matches[blockSize / 64];
+  uint64_t alive[blockSize / 64];
+  for (size_t block = begin; block < end; block += blockSize)
+  {
+    size_t count = std::min(blockSize, end - block);
+    babinov::selectRange(values + block, count, lower, upper, matches);
+    babinov::packFlags(isAlive + block, count, alive);
+    for (size_t i = 0; i < (count + 63) / 64; ++i)
+    {
+      visit(block + i * 64, matches[i] & alive[i]);
+    }
+  }
+}
+
+template< class T >
+void collectSelected(const T* values, const bool* isAlive, size_t begin, size_t end, T lower, T upper,
+  babinov::Vector< size_t >& slots)
+{
+  visitSelected(values, isAlive, begin, end, lower, upper, [&](size_t base, uint64_t word)
+  {
+    for (; word; word &= word - 1)
+    {
+      slots.pushBack(base + countTrailingZeros(word));
+    }
+  });
+}
+
+template< class T >
+size_t countSelected(const T* values, const bool* isAlive, size_t begin, size_t end, T lower, T upper)
+{
+  size_t count = 0;
+  visitSelected(values, isAlive, begin, end, lower, upper, [&](size_t, uint64_t word)
+  {
+    count += countBits(word);
+  });
+  return count;
+}
+
+#ifdef SCAN_USE_X86
+__attribute__((target("avx2")))
+size_t selectIntegersAvx2(const long long* values, size_t count, long long lower, long long upper, uint64_t* bitmap) noexcept
+{
+  const __m256i lowerBound = _mm256_set1_epi64x(lower);
+  const __m256i upperBound = _mm256_set1_epi64x(upper);
+  size_t i = 0;
+  for (; i + 64 <= count; i += 64)
+  {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 16)
+    {
+      unsigned int bits = 0;
+      for (size_t k = 0; k < 16; k += 4)
+      {
+        __m256i x = _mm256_loadu_si256(reinterpret_cast< const __m256i* >(values + i + j + k));
+        __m256i outside = _mm256_or_si256(_mm256_cmpgt_epi64(lowerBound, x), _mm256_cmpgt_epi64(x, upperBound));
+        bits |= _mm256_movemask_pd(_mm256_castsi256_pd(outside)) << k;
+      }
+      word |= uint64_t(~bits & 0xFFFF) << j;
+    }
+    bitmap[i / 64] = word;
+  }
+  return i;
+}
+
+__attribute__((target("avx2")))
+size_t selectRealsAvx2(const double* values, size_t count, double lower, double upper, uint64_t* bitmap) noexcept
+{
+  const __m256d lowerBound = _mm256_set1_pd(lower);
+  const __m256d upperBound = _mm256_set1_pd(upper);
+  size_t i = 0;
+  for (; i + 64 <= count; i += 64)
+  {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 16)
+    {
+      unsigned int bits = 0;
+      for (size_t k = 0; k < 16; k += 4)
+      {
+        __m256d x = _mm256_loadu_pd(values + i + j + k);
+        __m256d inside = _mm256_and_pd(_mm256_cmp_pd(x, lowerBound, _CMP_GE_OQ), _mm256_cmp_pd(x, upperBound, _CMP_LE_OQ));
+        bits |= _mm256_movemask_pd(inside) << k;
+      }
+      word |= uint64_t(bits) << j;
+    }
+    bitmap[i / 64] = word;
+  }
+  return i;
+}
+
+__attribute__((target("sse4.2")))
+size_t selectIntegersSse42(const long long* values, size_t count, long long lower, long long upper, uint64_t* bitmap) noexcept
+{
+  const __m128i lowerBound = _mm_set1_epi64x(lower);
+  const __m128i upperBound = _mm_set1_epi64x(upper);
+  size_t i = 0;
+  for (; i + 64 <= count; i += 64)
+  {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 8)
+    {
+      unsigned int bits = 0;
+      for (size_t k = 0; k < 8; k += 2)
+      {
+        __m128i x = _mm_loadu_si128(reinterpret_cast< const __m128i* >(values + i + j + k));
+        __m128i outside = _mm_or_si128(_mm_cmpgt_epi64(lowerBound, x), _mm_cmpgt_epi64(x, upperBound));
+        bits |= _mm_movemask_pd(_mm_castsi128_pd(outside)) << k;
+      }
+      word |= uint64_t(~bits & 0xFF) << j;
+    }
+    bitmap[i / 64] = word;
+  }
+  return i;
+}
+
+__attribute__((target("sse4.2")))
+size_t selectRealsSse42(const double* values, size_t count, double lower, double upper, uint64_t* bitmap) noexcept
+{
+  const __m128d lowerBound = _mm_set1_pd(lower);
+  const __m128d upperBound = _mm_set1_pd(upper);
+  size_t i = 0;
+  for (; i + 64 <= count; i += 64)
+  {
+    uint64_t word = 0;
+    for (size_t j = 0; j < 64; j += 8)
+    {
+      unsigned int bits = 0;
+      for (size_t k = 0; k < 8; k += 2)
+      {
+        __m128d x = _mm_loadu_pd(values + i + j + k);
+        __m128d inside = _mm_and_pd(_mm_cmpge_pd(x, lowerBound), _mm_cmple_pd(x, upperBound));
+        bits |= _mm_movemask_pd(inside) << k;
+      }
+      word |= uint64_t(bits) << j;
+    }
+    bitmap[i / 64] = word;
+  }
+  return i;
+}
+#endif
+
+namespace babinov
+{
+  bool makeRange(const Condition& condition, long long& lower, long long& upper) noexcept
+  {
+    const long long min = std::numeric_limits< long long >::min();
+    const long long max = std::numeric_limits< long long >::max();
+    long long value = condition.getInteger();
+    switch (condition.getOperation())
+    {
+    case EQUAL:
+      lower = value;
+      upper = value;
+      break;
+    case LESS:
+      if (value == min)
+      {
+        return false;
+      }
+      lower = min;
+      upper = value - 1;
+      break;
+    case LESS_EQUAL:
+      lower = min;
+      upper = value;
+      break;
+    case GREATER:
+      if (value == max)
+      {
+        return false;
+      }
+      lower = value + 1;
+      upper = max;
+      break;
+    case GREATER_EQUAL:
+      lower = value;
+      upper = max;
+      break;
+    case BETWEEN:
+      lower = value;
+      upper = condition.getUpperInteger();
+      break;
+    }
+    return lower <= upper;
+  }
+
+  bool makeRange(const Condition& condition, double& lower, double& upper) noexcept
+  {
+    const double infinity = std::numeric_limits< double >::infinity();
+    double value = condition.getReal();
+    if (std::isnan(value))
+    {
+      return false;
+    }
+    switch (condition.getOperation())
+    {
+    case EQUAL:
+      lower = value;
+      upper = value;
+      break;
+    case LESS:
+      lower = -infinity;
+      upper = std::nextafter(value, -infinity);
+      return value != -infinity;
+    case LESS_EQUAL:
+      lower = -infinity;
+      upper = value;
+      break;
+    case GREATER:
+      lower = std::nextafter(value, infinity);
+      upper = infinity;
+      return value != infinity;
+    case GREATER_EQUAL:
+      lower = value;
+      upper = infinity;
+      break;
+    case BETWEEN:
+      lower = value;
+      upper = condition.getUpperReal();
+      break;
+    }
+    return lower <= upper;
+  }
+
+  void selectRange(const long long* values, size_t count, long long lower, long long upper, uint64_t* bitmap) noexcept
+  {
+    size_t done = 0;
+#ifdef SCAN_USE_X86
+    SimdLevel level = getSimdLevel();
+    if (level == SIMD_AVX2)
+    {
+      done = selectIntegersAvx2(values, count, lower, upper, bitmap);
+    }
+    else if (level == SIMD_SSE42)
+    {
+      done = selectIntegersSse42(values, count, lower, upper, bitmap);
+    }
+#endif
+    std::memset(bitmap + done / 64, 0, ((count + 63) / 64 - done / 64) * sizeof(uint64_t));
+    selectRangeScalar(values, done, count, lower, upper, bitmap);
+  }
+
+  void selectRange(const double* values, size_t count, double lower, double upper, uint64_t* bitmap) noexcept
+  {
+    size_t done = 0;
+#ifdef SCAN_USE_X86
+    SimdLevel level = getSimdLevel();
+    if (level == SIMD_AVX2)
+    {
+      done = selectRealsAvx2(values, count, lower, upper, bitmap);
+    }
+    else if (level == SIMD_SSE42)
+    {
+      done = selectRealsSse42(values, count, lower, upper, bitmap);
+    }
+#endif
+    std::memset(bitmap + done / 64, 0, ((count + 63) / 64 - done / 64) * sizeof(uint64_t));
+    selectRangeScalar(values, done, count, lower, upper, bitmap);
+  }
+
+  void packFlags(const bool* flags, size_t count, uint64_t* bitmap) noexcept
+  {
+    size_t i = 0;
+#if defined(SCAN_USE_X86) && defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    for (; i + 64 <= count; i += 64)
+    {
+      uint64_t word = 0;
+      for (size_t j = 0; j < 64; j += 16)
+      {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast< const __m128i* >(flags + i + j));
+        word |= uint64_t(~_mm_movemask_epi8(_mm_cmpeq_epi8(bytes, zero)) & 0xFFFF) << j;
+      }
+      bitmap[i / 64] = word;
+    }
+#endif
+    std::memset(bitmap + i / 64, 0, ((count + 63) / 64 - i / 64) * sizeof(uint64_t));
+    for (; i < count; ++i)
+    {
+      if (flags[i])
+      {
+        bitmap[i / 64] |= uint64_t(1) << (i % 64);
+      }
+    }
+  }
+
+  void selectSlots(const long long* values, const bool* isAlive, size_t begin, size_t end,
+    long long lower, long long upper, Vector< size_t >& slots)
+  {
+    collectSelected(values, isAlive, begin, end, lower, upper, slots);
+  }
+
+  void selectSlots(const double* values, const bool* isAlive, size_t begin, size_t end,
+    double lower, double upper, Vector< size_t >& slots)
+  {
+    collectSelected(values, isAlive, begin, end, lower, upper, slots);
+  }
+
+  size_t countSlots(const long long* values, const bool* isAlive, size_t begin, size_t end,
+    long long lower, long long upper) noexcept
+  {
+    return countSelected(values, isAlive, begin, end, lower, upper);
+  }
+
+  size_t countSlots(const double* values, const bool* isAlive, size_t begin, size_t end,
+    double lower, double upper) noexcept
+  {
+    return countSelected(values, isAlive, begin, end, lower, upper);
+  }
+
+  const char* getSimdLevelName() noexcept
+  {
+    switch (getSimdLevel())
+    {
+    case SIMD_AVX2:
+      return "AVX2";
+    case SIMD_SSE42:
+      return "SSE4.2";
+    default:
+      return "scalar";
+    }
+  }
+}
@@ -0,0 +1,27 @@
+#ifndef SCAN_KERNELS_HPP
+#define SCAN_KERNELS_HPP
+#include <cstddef>
+#include <cstdint>
+
+#include "condition.hpp"
+#include "vector.hpp"
+
+namespace babinov
+{
+  bool makeRange(const Condition& condition, long long& lower, long long& upper) noexcept;
+  bool makeRange(const Condition& condition, double& lower, double& upper) noexcept;
+  void selectRange(const long long* values, size_t count, long long lower, long long upper, uint64_t* bitmap) noexcept;
+  void selectRange(const double* values, size_t count, double lower, double upper, uint64_t* bitmap) noexcept;
+  void packFlags(const bool* flags, size_t count, uint64_t* bitmap) noexcept;
+  void selectSlots(const long long* values, const bool* isAlive, size_t begin, size_t end,
+    long long lower, long long upper, Vector< size_t >& slots);
+  void selectSlots(const double* values, const bool* isAlive, size_t begin, size_t end,
+    double lower, double upper, Vector< size_t >& slots);
+  size_t countSlots(const long long* values, const bool* isAlive, size_t begin, size_t end,
+    long long lower, long long upper) noexcept;
+  size_t countSlots(const double* values, const bool* isAlive, size_t begin, size_t end,
+    double lower, double upper) noexcept;
+  const char* getSimdLevelName() noexcept;
+}
+
+#endif
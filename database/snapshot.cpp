@@ -0,0 +1,68 @@
+#include "snapshot.hpp"
+
+namespace babinov
+{
+  bool isSnapshot(const char* data, size_t size) noexcept
+  {
+    return (size >= sizeof(SNAPSHOT_MAGIC)) && (!std::memcmp(data, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)));
+  }
+
+  uint64_t checksum(const char* data, size_t size) noexcept
+  {
+    const uint64_t prime = 0x100000001b3ULL;
+    uint64_t hash = 0xcbf29ce484222325ULL ^ size;
+    size_t pos = 0;
+    for (; pos + sizeof(uint64_t) <= size; pos += sizeof(uint64_t))
+    {
+      uint64_t word = 0;
+      std::memcpy(&word, data + pos, sizeof(uint64_t));
+      hash = (hash ^ word) * prime;
+      hash ^= hash >> 29;
+    }
+    for (; pos < size; ++pos)
+    {
+      hash = (hash ^ static_cast< unsigned char >(data[pos])) * prime;
+    }
+    return hash;
+  }
+
+  void writeBlock(std::ostream& out, const char* payload, size_t size)
+  {
+    writeRaw< uint64_t >(out, size);
+    out.write(payload, size);
+    writeRaw< uint64_t >(out, checksum(payload, size));
+  }
+
+  SnapshotReader::SnapshotReader(const char* data, size_t size) noexcept:
+    pos_(data),
+    end_(data + size)
+  {}
+
+  const char* SnapshotReader::position() const noexcept
+  {
+    return pos_;
+  }
+
+  bool SnapshotReader::readBytes(const char*& bytes, size_t size) noexcept
+  {
+    if (size > static_cast< size_t >(end_ - pos_))
+    {
+      return false;
+    }
+    bytes = pos_;
+    pos_ += size;
+    return true;
+  }
+
+  bool SnapshotReader::readBlock(const char*& payload, size_t& size) noexcept
+  {
+    uint64_t payloadSize = 0;
+    uint64_t expected = 0;
+    if ((!read(payloadSize)) || (!readBytes(payload, payloadSize)) || (!read(expected)))
+    {
+      return false;
+    }
+    size = payloadSize;
+    return checksum(payload, size) == expected;
+  }
+}
@@ -0,0 +1,53 @@
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <ostream>
+
+namespace babinov
+{
+  const char SNAPSHOT_MAGIC[8] = { 'B', 'T', 'B', 'L', 'S', 'N', 'A', 'P' };
+  const uint32_t SNAPSHOT_VERSION = 1;
+  const uint32_t SNAPSHOT_BYTE_ORDER = 0x01020304;
+
+  bool isSnapshot(const char* data, size_t size) noexcept;
+  uint64_t checksum(const char* data, size_t size) noexcept;
+  void writeBlock(std::ostream& out, const char* payload, size_t size);
+
+  template< class T >
+  void writeRaw(std::ostream& out, const T& value)
+  {
+    out.write(reinterpret_cast< const char* >(&value), sizeof(T));
+  }
+
+  class SnapshotReader
+  {
+  public:
+    SnapshotReader(const char* data, size_t size) noexcept;
+
+    const char* position() const noexcept;
+    bool readBytes(const char*& bytes, size_t size) noexcept;
+    bool readBlock(const char*& payload, size_t& size) noexcept;
+    template< class T >
+    bool read(T& value) noexcept;
+
+  private:
+    const char* pos_;
+    const char* end_;
+  };
+
+  template< class T >
+  bool SnapshotReader::read(T& value) noexcept
+  {
+    const char* bytes = nullptr;
+    if (!readBytes(bytes, sizeof(T)))
+    {
+      return false;
+    }
+    std::memcpy(&value, bytes, sizeof(T));
+    return true;
+  }
+}
+
+#endif
@@ -0,0 +1,335 @@
+#include "table_loader.hpp"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LOADER_USE_MMAP
+#else
+#include <fstream>
+#include <sstream>
+#endif
+
+#include "column_store.hpp"
+#include "data_types.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+#include "value_parser.hpp"
+#include "vector.hpp"
+
+const size_t MIN_CHUNK_SIZE = 1 << 20;
+
+class MappedFile
+{
+public:
+  explicit MappedFile(const std::string& fileName);
+  MappedFile(const MappedFile&) = delete;
+  ~MappedFile();
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  bool isOpen() const noexcept;
+  const char* data() const noexcept;
+  size_t size() const noexcept;
+
+private:
+  bool isOpen_;
+  const char* data_;
+  size_t size_;
+#ifndef LOADER_USE_MMAP
+  std::string buffer_;
+#endif
+};
+
+MappedFile::MappedFile(const std::string& fileName):
+  isOpen_(false),
+  data_(nullptr),
+  size_(0)
+{
+#ifdef LOADER_USE_MMAP
+  int fd = ::open(fileName.c_str(), O_RDONLY);
+  if (fd == -1)
+  {
+    return;
+  }
+  struct stat info;
+  if ((::fstat(fd, &info) == -1) || (!S_ISREG(info.st_mode)))
+  {
+    ::close(fd);
+    return;
+  }
+  size_ = info.st_size;
+  if (size_)
+  {
+    void* mapped = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapped == MAP_FAILED)
+    {
+      ::close(fd);
+      size_ = 0;
+      return;
+    }
+    ::madvise(mapped, size_, MADV_SEQUENTIAL);
+    data_ = static_cast< const char* >(mapped);
+  }
+  ::close(fd);
+  isOpen_ = true;
+#else
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file.is_open())
+  {
+    return;
+  }
+  std::ostringstream content;
+  content << file.rdbuf();
+  buffer_ = content.str();
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  isOpen_ = true;
+#endif
+}
+
+MappedFile::~MappedFile()
+{
+#ifdef LOADER_USE_MMAP
+  if (data_)
+  {
+    ::munmap(const_cast< char* >(data_), size_);
+  }
+#endif
+}
+
+bool MappedFile::isOpen() const noexcept
+{
+  return isOpen_;
+}
+
+const char* MappedFile::data() const noexcept
+{
+  return data_;
+}
+
+size_t MappedFile::size() const noexcept
+{
+  return size_;
+}
+
+bool isSpace(char ch) noexcept
+{
+  return (ch == ' ') || (ch == '\n') || (ch == '\t') || (ch == '\r') || (ch == '\v') || (ch == '\f');
+}
+
+const char* skipSpaces(const char* pos, const char* end) noexcept
+{
+  while ((pos != end) && isSpace(*pos))
+  {
+    ++pos;
+  }
+  return pos;
+}
+
+std::string_view readToken(const char*& pos, const char* end) noexcept
+{
+  pos = skipSpaces(pos, end);
+  const char* begin = pos;
+  while ((pos != end) && (!isSpace(*pos)))
+  {
+    ++pos;
+  }
+  return std::string_view(begin, pos - begin);
+}
+
+bool parseValue(const char*& pos, const char* end, babinov::ColumnStore& column)
+{
+  babinov::DataType dataType = column.getDataType();
+  if (dataType == babinov::TEXT)
+  {
+    pos = skipSpaces(pos, end);
+    if ((pos == end) || (*pos != '\"'))
+    {
+      return false;
+    }
+    ++pos;
+    const char* close = static_cast< const char* >(std::memchr(pos, '\"', end - pos));
+    if (!close)
+    {
+      return false;
+    }
+    column.pushText(std::string_view(pos, close - pos));
+    pos = close + 1;
+    return true;
+  }
+  std::string_view token = readToken(pos, end);
+  if (dataType == babinov::REAL)
+  {
+    double value = 0.0;
+    if (babinov::parseReal(token, value) != babinov::PARSE_OK)
+    {
+      return false;
+    }
+    column.pushReal(value);
+    return true;
+  }
+  long long value = 0;
+  if (babinov::parseInteger(token, dataType, value) != babinov::PARSE_OK)
+  {
+    return false;
+  }
+  column.pushInteger(value);
+  return true;
+}
+
+bool parseRows(const char* pos, const char* end, babinov::Vector< babinov::ColumnStore >& rows)
+{
+  while ((pos = skipSpaces(pos, end)) != end)
+  {
+    if (*pos != '[')
+    {
+      return false;
+    }
+    ++pos;
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+      if (!parseValue(pos, end, rows[i]))
+      {
+        return false;
+      }
+    }
+    pos = skipSpaces(pos, end);
+    if ((pos == end) || (*pos != ']'))
+    {
+      return false;
+    }
+    ++pos;
+  }
+  return true;
+}
+
+const char* parseHeader(const char* pos, const char* end, babinov::Vector< babinov::Table::Column >& columns)
+{
+  size_t nColumns = 0;
+  if ((babinov::parseNumber(readToken(pos, end), nColumns) != babinov::PARSE_OK) || (!nColumns)
+    || (readToken(pos, end) != "COLUMNS:"))
+  {
+    return nullptr;
+  }
+  for (size_t i = 0; i < nColumns; ++i)
+  {
+    pos = skipSpaces(pos, end);
+    const char* colon = static_cast< const char* >(std::memchr(pos, ':', end - pos));
+    if (!colon)
+    {
+      return nullptr;
+    }
+    std::string name(pos, colon);
+    pos = colon + 1;
+    std::string dataType(readToken(pos, end));
+    const babinov::DataType* desired = babinov::DATA_TYPES_FROM_STR.findValue(dataType);
+    if (!desired)
+    {
+      return nullptr;
+    }
+    if (i)
+    {
+      columns.pushBack({ std::move(name), *desired });
+    }
+  }
+  return pos;
+}
+
+babinov::Vector< const char* > splitIntoChunks(const char* begin, const char* end, size_t nChunks)
+{
+  size_t size = end - begin;
+  nChunks = std::max< size_t >(std::min(nChunks, size / MIN_CHUNK_SIZE), 1);
+  babinov::Vector< const char* > bounds;
+  bounds.pushBack(begin);
+  for (size_t i = 1; i < nChunks; ++i)
+  {
+    const char* pos = std::max(begin + (size / nChunks) * i, bounds[bounds.size() - 1]);
+    const char* newLine = static_cast< const char* >(std::memchr(pos, '\n', end - pos));
+    if (!newLine)
+    {
+      break;
+    }
+    if (newLine + 1 != bounds[bounds.size() - 1])
+    {
+      bounds.pushBack(newLine + 1);
+    }
+  }
+  bounds.pushBack(end);
+  return bounds;
+}
+
+namespace babinov
+{
+  Table loadTable(const std::string& fileName)
+  {
+    MappedFile file(fileName);
+    if (!file.isOpen())
+    {
+      throw std::runtime_error("Cannot open file");
+    }
+    if (isSnapshot(file.data(), file.size()))
+    {
+      Table table;
+      table.readSnapshot(file.data(), file.size());
+      table.encodeTexts();
+      return table;
+    }
+    const char* end = file.data() + file.size();
+    Vector< Table::Column > columns;
+    const char* rowsBegin = file.size() ? parseHeader(file.data(), end, columns) : nullptr;
+    if (!rowsBegin)
+    {
+      throw std::invalid_argument("Invalid table");
+    }
+    Table table(columns);
+    Vector< ColumnStore > emptyRows;
+    for (size_t i = 0; i < table.getColumns().size(); ++i)
+    {
+      emptyRows.pushBack(ColumnStore(table.getColumns()[i].second));
+    }
+
+    ThreadPool& pool = getScanPool();
+    Vector< const char* > bounds = splitIntoChunks(rowsBegin, end, pool.size());
+    size_t nChunks = bounds.size() - 1;
+    Vector< Vector< ColumnStore > > chunks;
+    Vector< bool > isParsed;
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      chunks.pushBack(emptyRows);
+      isParsed.pushBack(false);
+    }
+    pool.parallelFor(nChunks, [&](size_t i)
+    {
+      isParsed[i] = parseRows(bounds[i], bounds[i + 1], chunks[i]);
+    });
+
+    bool isCorrect = true;
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      isCorrect = isCorrect && isParsed[i];
+    }
+    if ((!isCorrect) && (nChunks > 1))
+    {
+      // A chunk border may fall inside a multi-line TEXT value; recheck sequentially.
+      chunks.clear();
+      chunks.pushBack(emptyRows);
+      isCorrect = parseRows(rowsBegin, end, chunks[0]);
+    }
+    if (!isCorrect)
+    {
+      throw std::invalid_argument("Invalid table");
+    }
+    for (size_t i = 0; i < chunks.size(); ++i)
+    {
+      table.appendRows(std::move(chunks[i]));
+    }
+    table.encodeTexts();
+    return table;
+  }
+}
@@ -0,0 +1,12 @@
+#ifndef TABLE_LOADER_HPP
+#define TABLE_LOADER_HPP
+#include <string>
+
+#include "tables.hpp"
+
+namespace babinov
+{
+  Table loadTable(const std::string& fileName);
+}
+
+#endif
@@ -1,302 +1,1521 @@
 #include "tables.hpp"
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
+#include <cstring>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include <utility>
 
-#include "hash_table.hpp"
+#include "hash_policies.hpp"
 #include "delimiters.hpp"
+#include "external_sort.hpp"
+#include "snapshot.hpp"
+#include "thread_pool.hpp"
+#include "value_parser.hpp"
 
-bool isCorrectValue(const std::string& value, babinov::DataType dataType)
+const double SCAN_COST = 1.0;
+const double PROBE_COST = 2.0;
+const double TEXT_COST_FACTOR = 4.0;
+
+void uniteSlots(babinov::Vector< size_t >& slots, const babinov::Vector< size_t >& other)
+{
+  babinov::Vector< size_t > united;
+  united.reserve(slots.size() + other.size());
+  size_t i = 0;
+  size_t j = 0;
+  while ((i < slots.size()) || (j < other.size()))
+  {
+    if ((j == other.size()) || ((i < slots.size()) && (slots[i] < other[j])))
+    {
+      united.pushBack(slots[i++]);
+    }
+    else
+    {
+      i += (i < slots.size()) && (slots[i] == other[j]);
+      united.pushBack(other[j++]);
+    }
+  }
+  slots.swap(united);
+}
+
+void sortAscending(babinov::Vector< size_t >& slots)
+{
+  std::sort(slots.data(), slots.data() + slots.size());
+}
+
+template< class Key >
+struct PartialGroups
+{
+  babinov::HashMap< Key, size_t > ids;
+  babinov::Vector< Key > keys;
+  babinov::Vector< size_t > firstSlots;
+  babinov::Vector< babinov::Vector< babinov::Accumulator > > accumulators;
+
+  explicit PartialGroups(size_t nAggregates):
+    ids(),
+    keys(),
+    firstSlots(),
+    accumulators()
+  {
+    for (size_t i = 0; i < nAggregates; ++i)
+    {
+      accumulators.pushBack(babinov::Vector< babinov::Accumulator >());
+    }
+  }
+
+  size_t insert(const Key& key, size_t firstSlot)
+  {
+    auto inserted = ids.insert(key, keys.size());
+    if (inserted.second)
+    {
+      keys.pushBack(key);
+      firstSlots.pushBack(firstSlot);
+      for (size_t i = 0; i < accumulators.size(); ++i)
+      {
+        accumulators[i].pushBack(babinov::Accumulator());
+      }
+    }
+    return (*inserted.first).second;
+  }
+
+  template< class Getter >
+  void add(const babinov::Vector< size_t >& slots, Getter getKey, babinov::Vector< size_t >& groups)
+  {
+    groups.clear();
+    groups.reserve(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+      groups.pushBack(insert(getKey(slots[i]), slots[i]));
+    }
+  }
+
+  void accumulate(const babinov::Vector< babinov::Aggregate >& aggregates,
+    const babinov::Vector< babinov::ColumnStore >& data, const babinov::Vector< size_t >& slots,
+    const babinov::Vector< size_t >& groups)
+  {
+    for (size_t i = 0; i < aggregates.size(); ++i)
+    {
+      if (aggregates[i].function != babinov::COUNT)
+      {
+        data[aggregates[i].columnIndex].accumulate(slots, groups, accumulators[i]);
+        continue;
+      }
+      for (size_t j = 0; j < groups.size(); ++j)
+      {
+        ++accumulators[i][groups[j]].count;
+      }
+    }
+  }
+
+  void merge(const PartialGroups< Key >& other)
+  {
+    for (size_t i = 0; i < other.keys.size(); ++i)
+    {
+      size_t group = insert(other.keys[i], other.firstSlots[i]);
+      for (size_t j = 0; j < accumulators.size(); ++j)
+      {
+        accumulators[j][group].merge(other.accumulators[j][i]);
+      }
+    }
+  }
+};
+
+namespace babinov
 {
-  size_t size = value.size();
-  size_t* pos = &size;
-  try
+  bool isCorrectName(const std::string& name)
+  {
+    auto pred = [&](const char ch) -> bool
+    {
+      return !((std::isalnum(ch)) || (ch == '_'));
+    };
+    return (std::find_if(name.cbegin(), name.cend(), pred)) == (name.cend());
+  }
+
+  Table::RowRef::RowRef(const Table& table, size_t slot) noexcept:
+    table_(&table),
+    slot_(slot)
+  {}
+
+  size_t Table::RowRef::getSlot() const noexcept
+  {
+    return slot_;
+  }
+
+  size_t Table::RowRef::getId() const
+  {
+    return table_->data_[0].getInteger(slot_);
+  }
+
+  const ColumnStore& Table::RowRef::getColumn(size_t columnIndex) const
+  {
+    return table_->data_[columnIndex];
+  }
+
+  std::string Table::RowRef::getAsString(size_t columnIndex) const
+  {
+    return table_->data_[columnIndex].getAsString(slot_);
+  }
+
+  Table::Row Table::RowRef::toRow() const
+  {
+    return table_->getRow(slot_);
+  }
+
+  Table::Row Table::RowRef::toRow(const Projection& columns) const
+  {
+    return table_->getRow(slot_, columns);
+  }
+
+  void Table::RowRef::print(std::ostream& out) const
+  {
+    table_->printSlot(out, slot_);
+  }
+
+  void Table::RowRef::print(std::ostream& out, const Projection& columns) const
+  {
+    table_->printSlot(out, slot_, columns);
+  }
+
+  Table::Table():
+    columns_(),
+    data_(),
+    isAlive_(),
+    rowSlots_(),
+    indexes_(),
+    orderedIndexes_(),
+    nDeleted_(0),
+    lastId_(0),
+    isIdOrdered_(true)
+  {}
+
+  Table::Table(const Vector< Column >& columns):
+    data_(),
+    isAlive_(),
+    rowSlots_(),
+    indexes_(),
+    orderedIndexes_(),
+    nDeleted_(0),
+    lastId_(0),
+    isIdOrdered_(true)
+  {
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      Column column = columns[i];
+      if ((!isCorrectName(column.first)) || (column.second == PK))
+      {
+        throw std::invalid_argument("Invalid columns");
+      }
+    }
+    Vector< Column > tempColumns;
+    tempColumns.pushBack({"id", PK});
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      tempColumns.pushBack(columns[i]);
+    }
+    for (size_t i = 0; i < tempColumns.size(); ++i)
+    {
+      data_.pushBack(ColumnStore(tempColumns[i].second));
+    }
+    columns_ = std::move(tempColumns);
+  }
+
+  Table::Table(const Table& other):
+    columns_(other.columns_),
+    data_(other.data_),
+    isAlive_(other.isAlive_),
+    rowSlots_(other.rowSlots_),
+    indexes_(other.indexes_),
+    orderedIndexes_(other.orderedIndexes_),
+    nDeleted_(other.nDeleted_),
+    lastId_(other.lastId_),
+    isIdOrdered_(other.isIdOrdered_)
+  {}
+
+  Table::Table(Table&& other) noexcept:
+    columns_(std::move(other.columns_)),
+    data_(std::move(other.data_)),
+    isAlive_(std::move(other.isAlive_)),
+    rowSlots_(std::move(other.rowSlots_)),
+    indexes_(std::move(other.indexes_)),
+    orderedIndexes_(std::move(other.orderedIndexes_)),
+    nDeleted_(other.nDeleted_),
+    lastId_(other.lastId_),
+    isIdOrdered_(other.isIdOrdered_)
+  {
+    other.nDeleted_ = 0;
+    other.lastId_ = 0;
+    other.isIdOrdered_ = true;
+  }
+
+  Table& Table::operator=(const Table& other)
+  {
+    if (this != &other)
+    {
+      Table temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  Table& Table::operator=(Table&& other) noexcept
+  {
+    if (this != &other)
+    {
+      Table temp(std::move(other));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  bool Table::isCorrectRow(const Row& row) const
   {
-    if (dataType == babinov::PK)
+    if (row.size() != (columns_.size() - 1))
+    {
+      return false;
+    }
+    for (size_t i = 0; i < row.size(); ++i)
     {
-      if (value.size() && value[0] == '-')
+      if (checkValue(row[i], columns_[i + 1].second) != PARSE_OK)
       {
         return false;
       }
-      std::stoull(value, pos);
     }
-    else if (dataType == babinov::INTEGER)
+    return true;
+  }
+
+  const Vector< Table::Column >& Table::getColumns() const
+  {
+    return columns_;
+  }
+
+  size_t Table::getColumnIndex(const std::string& columnName) const
+  {
+    size_t index = 0;
+    for (; (index < columns_.size()) && (columns_[index].first != columnName); ++index) {}
+    if (index == columns_.size())
+    {
+      throw std::out_of_range("Column doesn't exist");
+    }
+    return index;
+  }
+
+  const ColumnStore& Table::getColumnData(size_t columnIndex) const
+  {
+    if (columnIndex >= data_.size())
+    {
+      throw std::out_of_range("Column doesn't exist");
+    }
+    return data_[columnIndex];
+  }
+
+  size_t Table::size() const noexcept
+  {
+    return slotsCount() - nDeleted_;
+  }
+
+  size_t Table::getLastId() const noexcept
+  {
+    return lastId_;
+  }
+
+  bool Table::hasRow(size_t rowId) const noexcept
+  {
+    return rowSlots_.find(rowId) != NO_SLOT;
+  }
+
+  void Table::insert(const Row& row)
+  {
+    if (!isCorrectRow(row))
+    {
+      throw std::invalid_argument("Invalid row");
+    }
+    size_t pk = lastId_ + 1;
+    Row processed;
+    processed.reserve(row.size() + 1);
+    processed.pushBack(std::to_string(pk));
+    for (size_t i = 0; i < row.size(); ++i)
+    {
+      processed.pushBack(row[i]);
+    }
+    pushSlot(processed);
+    ++lastId_;
+  }
+
+  Condition Table::makeCondition(const std::string& columnName, const std::string& value) const
+  {
+    return makeCondition(columnName, EQUAL, value);
+  }
+
+  Condition Table::makeCondition(const std::string& columnName, CompareOperation operation,
+    const std::string& value, const std::string& upperValue) const
+  {
+    size_t index = getColumnIndex(columnName);
+    DataType dataType = columns_[index].second;
+    if ((checkValue(value, dataType) != PARSE_OK)
+      || ((operation == BETWEEN) && (checkValue(upperValue, dataType) != PARSE_OK)))
+    {
+      throw std::invalid_argument("Invalid value");
+    }
+    return Condition(index, dataType, operation, value, upperValue);
+  }
+
+  Condition Table::planCondition(const Condition& condition) const
+  {
+    if (condition.isPlanned() || !condition.isCompound())
+    {
+      return condition;
+    }
+    const Vector< Condition >& operands = condition.getOperands();
+    bool isConjunction = condition.getLogicalOperation() == LOGICAL_AND;
+    Vector< Condition > planned;
+    Vector< double > selectivities;
+    Vector< std::pair< double, size_t > > ranks;
+    double probeCost = 0.0;
+    for (size_t i = 0; i < operands.size(); ++i)
+    {
+      planned.pushBack(planCondition(operands[i]));
+      selectivities.pushBack(estimateSelectivity(operands[i]));
+      double cost = estimateCost(operands[i], false);
+      double rank = cost / (isConjunction ? 1.0 - selectivities[i] : selectivities[i]);
+      ranks.pushBack(std::make_pair(isIndexed(planned[i]) ? selectivities[i] - 1.0 : rank, i));
+      probeCost += cost;
+    }
+    if (condition.getLogicalOperation() == LOGICAL_NOT)
+    {
+      Condition negation(LOGICAL_NOT, planned);
+      negation.setPlanned();
+      return negation;
+    }
+    std::sort(ranks.data(), ranks.data() + ranks.size());
+    if (isConjunction && (ranks[0].first >= 0.0))
+    {
+      size_t driver = 0;
+      double bestCost = 0.0;
+      for (size_t i = 0; i < ranks.size(); ++i)
+      {
+        size_t index = ranks[i].second;
+        double probeRest = probeCost - estimateCost(operands[index], false);
+        double cost = estimateCost(operands[index], true) + selectivities[index] * probeRest;
+        if ((i == 0) || (cost < bestCost))
+        {
+          driver = i;
+          bestCost = cost;
+        }
+      }
+      std::rotate(ranks.data(), ranks.data() + driver, ranks.data() + driver + 1);
+    }
+    Vector< Condition > ordered;
+    for (size_t i = 0; i < ranks.size(); ++i)
+    {
+      ordered.pushBack(planned[ranks[i].second]);
+    }
+    Condition result(condition.getLogicalOperation(), ordered);
+    result.setPlanned();
+    return result;
+  }
+
+  Table::AccessPath Table::explain(const Condition& condition) const
+  {
+    Condition planned = planCondition(condition);
+    AccessPath path{ FULL_SCAN, 0, estimateSelectivity(planned) * size() };
+    const Condition* driver = &planned;
+    if (!isIndexed(planned))
+    {
+      while (driver->isCompound())
+      {
+        driver = &driver->getOperands()[0];
+      }
+      path.columnIndex = driver->getColumnIndex();
+      return path;
+    }
+    while (driver->getLogicalOperation() == LOGICAL_AND)
+    {
+      const Vector< Condition >& operands = driver->getOperands();
+      size_t first = 0;
+      while (!isIndexed(operands[first]))
+      {
+        ++first;
+      }
+      driver = &operands[first];
+    }
+    path.columnIndex = driver->getColumnIndex();
+    if (driver->isCompound())
+    {
+      path.method = INDEX_UNION;
+    }
+    else if (path.columnIndex == 0)
+    {
+      path.method = ID_LOOKUP;
+      path.estimatedRows = std::min(path.estimatedRows, 1.0);
+    }
+    else
+    {
+      bool isOrdered = orderedIndexes_.find(path.columnIndex) != orderedIndexes_.cend();
+      path.method = isOrdered ? ORDERED_INDEX_RANGE : HASH_INDEX_LOOKUP;
+    }
+    return path;
+  }
+
+  Table::Projection Table::makeProjection(const Vector< std::string >& columnNames) const
+  {
+    Projection columns;
+    columns.reserve(columnNames.size());
+    for (size_t i = 0; i < columnNames.size(); ++i)
+    {
+      columns.pushBack(getColumnIndex(columnNames[i]));
+    }
+    return columns;
+  }
+
+  void Table::appendRows(Vector< ColumnStore >&& rows)
+  {
+    if ((!data_.size()) || (rows.size() != data_.size()))
+    {
+      throw std::invalid_argument("Invalid columns");
+    }
+    size_t nRows = rows[0].size();
+    for (size_t i = 0; i < rows.size(); ++i)
+    {
+      if ((rows[i].getDataType() != columns_[i].second) || (rows[i].size() != nRows))
+      {
+        throw std::invalid_argument("Invalid columns");
+      }
+    }
+    size_t first = slotsCount();
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      data_[i].append(std::move(rows[i]));
+    }
+    isAlive_.reserve(first + nRows);
+    for (size_t slot = first; slot < first + nRows; ++slot)
+    {
+      isAlive_.pushBack(true);
+      size_t id = data_[0].getInteger(slot);
+      rowSlots_.insert(id, slot);
+      trackIdOrder(slot);
+      for (auto it = indexes_.begin(); it != indexes_.end(); ++it)
+      {
+        (*it).second.insert(data_[(*it).first], slot, id);
+      }
+      for (auto it = orderedIndexes_.begin(); it != orderedIndexes_.end(); ++it)
+      {
+        (*it).second.insert(data_[(*it).first], slot, id);
+      }
+      lastId_ = std::max(lastId_, id);
+    }
+  }
+
+  void Table::advanceLastId(size_t lastId) noexcept
+  {
+    lastId_ = std::max(lastId_, lastId);
+  }
+
+  size_t Table::encodeTexts()
+  {
+    size_t nEncoded = 0;
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      nEncoded += data_[i].encode();
+    }
+    return nEncoded;
+  }
+
+  Vector< Table::Row > Table::select(const std::string& columnName, const std::string& value) const
+  {
+    return select(makeCondition(columnName, value));
+  }
+
+  Vector< Table::Row > Table::select(const Condition& condition) const
+  {
+    return collectRows(findSlots(planCondition(condition)), nullptr);
+  }
+
+  Vector< Table::Row > Table::select(const Condition& condition, const Projection& columns) const
+  {
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      if (columns[i] >= columns_.size())
+      {
+        throw std::out_of_range("Column doesn't exist");
+      }
+    }
+    return collectRows(findSlots(planCondition(condition)), &columns);
+  }
+
+  Vector< Table::Row > Table::collectRows(const Vector< size_t >& slots, const Projection* columns) const
+  {
+    Vector< Row > result;
+    size_t nChunks = (slots.size() + SCAN_CHUNK_SIZE_ - 1) / SCAN_CHUNK_SIZE_;
+    if (nChunks <= 1)
+    {
+      for (size_t i = 0; i < slots.size(); ++i)
+      {
+        result.pushBack(columns ? getRow(slots[i], *columns) : getRow(slots[i]));
+      }
+      return result;
+    }
+    Vector< Vector< Row > > chunks;
+    chunks.reserve(nChunks);
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      chunks.pushBack(Vector< Row >());
+    }
+    getScanPool().parallelFor(nChunks, [&](size_t i)
+    {
+      size_t end = std::min((i + 1) * SCAN_CHUNK_SIZE_, slots.size());
+      chunks[i].reserve(end - i * SCAN_CHUNK_SIZE_);
+      for (size_t j = i * SCAN_CHUNK_SIZE_; j < end; ++j)
+      {
+        chunks[i].pushBack(columns ? getRow(slots[j], *columns) : getRow(slots[j]));
+      }
+    });
+    result.reserve(slots.size());
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      for (size_t j = 0; j < chunks[i].size(); ++j)
+      {
+        result.pushBack(std::move(chunks[i][j]));
+      }
+    }
+    return result;
+  }
+
+  void Table::forEach(const RowVisitor& visitor) const
+  {
+    scanFrom(nullptr, 0, visitor);
+  }
+
+  void Table::forEach(const Condition& condition, const RowVisitor& visitor) const
+  {
+    Condition planned = planCondition(condition);
+    scanFrom(&planned, 0, visitor);
+  }
+
+  void Table::forEachAfter(size_t rowId, const RowVisitor& visitor) const
+  {
+    scanFrom(nullptr, findResumeSlot(rowId), visitor);
+  }
+
+  void Table::forEachAfter(size_t rowId, const Condition& condition, const RowVisitor& visitor) const
+  {
+    Condition planned = planCondition(condition);
+    scanFrom(&planned, findResumeSlot(rowId), visitor);
+  }
+
+  void Table::forEachSorted(const SortOrder& order, size_t limit, const RowVisitor& visitor) const
+  {
+    visitSorted(nullptr, order, limit, nullptr, visitor);
+  }
+
+  void Table::forEachSorted(const SortOrder& order, size_t limit, const Projection& columns,
+    const RowVisitor& visitor) const
+  {
+    visitSorted(nullptr, order, limit, &columns, visitor);
+  }
+
+  void Table::forEachSorted(const Condition& condition, const SortOrder& order, size_t limit,
+    const RowVisitor& visitor) const
+  {
+    visitSorted(&condition, order, limit, nullptr, visitor);
+  }
+
+  void Table::forEachSorted(const Condition& condition, const SortOrder& order, size_t limit, const Projection& columns,
+    const RowVisitor& visitor) const
+  {
+    visitSorted(&condition, order, limit, &columns, visitor);
+  }
+
+  void Table::visitSorted(const Condition* condition, const SortOrder& order, size_t limit, const Projection* columns,
+    const RowVisitor& visitor) const
+  {
+    auto source = [this, condition](const SlotVisitor& emit)
+    {
+      auto emitSlot = [&emit](const RowRef& row)
+      {
+        return emit(row.getSlot());
+      };
+      if (condition)
+      {
+        forEach(*condition, emitSlot);
+      }
+      else
+      {
+        forEach(emitSlot);
+      }
+    };
+    size_t pending[PREFETCH_DISTANCE_];
+    size_t nPending = 0;
+    size_t next = 0;
+    bool isStopped = false;
+    sortSlots(getColumnData(order.columnIndex), order.isDescending, limit, source, [&](size_t slot)
+    {
+      size_t nColumns = columns ? columns->size() : data_.size();
+      for (size_t i = 0; i < nColumns; ++i)
+      {
+        data_[columns ? (*columns)[i] : i].prefetch(slot);
+      }
+      if (nPending < PREFETCH_DISTANCE_)
+      {
+        pending[nPending++] = slot;
+        return true;
+      }
+      size_t ready = pending[next];
+      pending[next] = slot;
+      next = (next + 1) % PREFETCH_DISTANCE_;
+      isStopped = !visitor(RowRef(*this, ready));
+      return !isStopped;
+    });
+    for (size_t i = 0; (i < nPending) && !isStopped; ++i)
+    {
+      isStopped = !visitor(RowRef(*this, pending[(next + i) % PREFETCH_DISTANCE_]));
+    }
+  }
+
+  size_t Table::count(const Condition& condition) const
+  {
+    Condition planned = planCondition(condition);
+    if (isIndexed(planned))
+    {
+      return findSlots(planned).size();
+    }
+    size_t nSlots = slotsCount();
+    size_t nChunks = (nSlots + SCAN_CHUNK_SIZE_ - 1) / SCAN_CHUNK_SIZE_;
+    Vector< size_t > counts;
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      counts.pushBack(0);
+    }
+    getScanPool().parallelFor(nChunks, [&](size_t i)
+    {
+      size_t begin = i * SCAN_CHUNK_SIZE_;
+      size_t end = std::min(begin + SCAN_CHUNK_SIZE_, nSlots);
+      if (!planned.isCompound())
+      {
+        counts[i] = data_[planned.getColumnIndex()].count(planned, isAlive_, begin, end);
+        return;
+      }
+      Vector< size_t > slots;
+      filterChunk(planned, begin, end, slots);
+      counts[i] = slots.size();
+    });
+    size_t result = 0;
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      result += counts[i];
+    }
+    return result;
+  }
+
+  Vector< Accumulator > Table::aggregate(const Vector< Aggregate >& aggregates) const
+  {
+    return accumulate(aggregates, nullptr);
+  }
+
+  Vector< Accumulator > Table::aggregate(const Vector< Aggregate >& aggregates, const Condition& condition) const
+  {
+    Condition planned = planCondition(condition);
+    return accumulate(aggregates, &planned);
+  }
+
+  Vector< Table::Group > Table::groupBy(size_t columnIndex, const Vector< Aggregate >& aggregates) const
+  {
+    return group(columnIndex, aggregates, nullptr);
+  }
+
+  Vector< Table::Group > Table::groupBy(size_t columnIndex, const Vector< Aggregate >& aggregates,
+    const Condition& condition) const
+  {
+    Condition planned = planCondition(condition);
+    return group(columnIndex, aggregates, &planned);
+  }
+
+  bool Table::update(size_t rowId, const std::string& columnName, const std::string& value)
+  {
+    if (columnName == "id")
+    {
+      throw std::logic_error("Cannot update id field");
+    }
+    size_t index = getColumnIndex(columnName);
+    if (checkValue(value, columns_[index].second) != PARSE_OK)
+    {
+      throw std::invalid_argument("Invalid value");
+    }
+    size_t slot = rowSlots_.find(rowId);
+    if (slot == NO_SLOT)
+    {
+      return false;
+    }
+    auto indexIter = indexes_.find(index);
+    auto orderedIndexIter = orderedIndexes_.find(index);
+    if (indexIter != indexes_.end())
+    {
+      (*indexIter).second.erase(data_[index], slot, rowId);
+    }
+    if (orderedIndexIter != orderedIndexes_.end())
+    {
+      (*orderedIndexIter).second.erase(data_[index], slot, rowId);
+    }
+    data_[index].set(slot, value);
+    if (indexIter != indexes_.end())
+    {
+      (*indexIter).second.insert(data_[index], slot, rowId);
+    }
+    if (orderedIndexIter != orderedIndexes_.end())
+    {
+      (*orderedIndexIter).second.insert(data_[index], slot, rowId);
+    }
+    return true;
+  }
+
+  size_t Table::update(const Condition& condition, const std::string& columnName, const std::string& value)
+  {
+    if (columnName == "id")
+    {
+      throw std::logic_error("Cannot update id field");
+    }
+    if (checkValue(value, columns_[getColumnIndex(columnName)].second) != PARSE_OK)
+    {
+      throw std::invalid_argument("Invalid value");
+    }
+    Vector< size_t > slots = findSlots(planCondition(condition));
+    Vector< size_t > ids;
+    ids.reserve(slots.size());
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+      ids.pushBack(data_[0].getInteger(slots[i]));
+    }
+    for (size_t i = 0; i < ids.size(); ++i)
+    {
+      update(ids[i], columnName, value);
+    }
+    return ids.size();
+  }
+
+  bool Table::del(const std::string& columnName, const std::string& value)
+  {
+    return del(makeCondition(columnName, value));
+  }
+
+  bool Table::del(const Condition& condition)
+  {
+    Vector< size_t > slots = findSlots(planCondition(condition));
+    for (size_t i = 0; i < slots.size(); ++i)
+    {
+      eraseSlot(slots[i]);
+    }
+    compact();
+    return !slots.isEmpty();
+  }
+
+  void Table::createIndex(const std::string& columnName, IndexType indexType)
+  {
+    size_t index = getColumnIndex(columnName);
+    if ((index == 0) || hasIndex(index))
+    {
+      throw std::logic_error("Index already exists");
+    }
+    HashIndex hashIndex(columns_[index].second);
+    OrderedIndex orderedIndex(columns_[index].second);
+    const ColumnStore& ids = data_[0];
+    for (size_t slot = 0; slot < slotsCount(); ++slot)
+    {
+      if (!isAlive_[slot])
+      {
+        continue;
+      }
+      if (indexType == HASH_INDEX)
+      {
+        hashIndex.insert(data_[index], slot, ids.getInteger(slot));
+      }
+      else
+      {
+        orderedIndex.insert(data_[index], slot, ids.getInteger(slot));
+      }
+    }
+    if (indexType == HASH_INDEX)
+    {
+      indexes_.insert(index, std::move(hashIndex));
+    }
+    else
+    {
+      orderedIndexes_.insert(index, std::move(orderedIndex));
+    }
+  }
+
+  bool Table::dropIndex(const std::string& columnName)
+  {
+    size_t index = getColumnIndex(columnName);
+    return indexes_.erase(index) || orderedIndexes_.erase(index);
+  }
+
+  bool Table::hasIndex(size_t columnIndex) const
+  {
+    return (indexes_.find(columnIndex) != indexes_.cend())
+      || (orderedIndexes_.find(columnIndex) != orderedIndexes_.cend());
+  }
+
+  void Table::swap(Table& other) noexcept
+  {
+    std::swap(columns_, other.columns_);
+    std::swap(data_, other.data_);
+    std::swap(isAlive_, other.isAlive_);
+    std::swap(rowSlots_, other.rowSlots_);
+    std::swap(indexes_, other.indexes_);
+    std::swap(orderedIndexes_, other.orderedIndexes_);
+    std::swap(nDeleted_, other.nDeleted_);
+    std::swap(lastId_, other.lastId_);
+    std::swap(isIdOrdered_, other.isIdOrdered_);
+  }
+
+  void Table::clear() noexcept
+  {
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      data_[i].clear();
+    }
+    isAlive_.clear();
+    rowSlots_.clear();
+    for (auto it = indexes_.begin(); it != indexes_.end(); ++it)
+    {
+      (*it).second.clear();
+    }
+    for (auto it = orderedIndexes_.begin(); it != orderedIndexes_.end(); ++it)
+    {
+      (*it).second.clear();
+    }
+    nDeleted_ = 0;
+    lastId_ = 0;
+    isIdOrdered_ = true;
+  }
+
+  size_t Table::slotsCount() const noexcept
+  {
+    return isAlive_.size();
+  }
+
+  Table::Row Table::getRow(size_t slot) const
+  {
+    Row row;
+    row.reserve(data_.size());
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      row.pushBack(data_[i].getAsString(slot));
+    }
+    return row;
+  }
+
+  Table::Row Table::getRow(size_t slot, const Projection& columns) const
+  {
+    Row row;
+    row.reserve(columns.size());
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      row.pushBack(data_[columns[i]].getAsString(slot));
+    }
+    return row;
+  }
+
+  size_t Table::findResumeSlot(size_t rowId) const
+  {
+    size_t slot = rowSlots_.find(rowId);
+    if (slot != NO_SLOT)
+    {
+      return slot + 1;
+    }
+    if (!isIdOrdered_)
+    {
+      // Ids loaded out of order: prefer the deleted row's own slot, otherwise the first greater id.
+      size_t firstGreater = slotsCount();
+      for (size_t i = 0; i < slotsCount(); ++i)
+      {
+        size_t id = data_[0].getInteger(i);
+        if (id == rowId)
+        {
+          return i + 1;
+        }
+        if ((id > rowId) && (firstGreater == slotsCount()))
+        {
+          firstGreater = i;
+        }
+      }
+      return firstGreater;
+    }
+    size_t low = 0;
+    size_t high = slotsCount();
+    while (low < high)
+    {
+      size_t middle = low + (high - low) / 2;
+      if (static_cast< size_t >(data_[0].getInteger(middle)) <= rowId)
+      {
+        low = middle + 1;
+      }
+      else
+      {
+        high = middle;
+      }
+    }
+    return low;
+  }
+
+  void Table::scanFrom(const Condition* condition, size_t firstSlot, const RowVisitor& visitor) const
+  {
+    size_t nSlots = slotsCount();
+    if (!condition)
+    {
+      for (size_t slot = firstSlot; slot < nSlots; ++slot)
+      {
+        if (isAlive_[slot] && !visitor(RowRef(*this, slot)))
+        {
+          return;
+        }
+      }
+      return;
+    }
+    if (isIndexed(*condition))
+    {
+      Vector< size_t > slots = findSlots(*condition);
+      sortAscending(slots);
+      for (size_t i = 0; i < slots.size(); ++i)
+      {
+        if ((slots[i] >= firstSlot) && !visitor(RowRef(*this, slots[i])))
+        {
+          return;
+        }
+      }
+      return;
+    }
+    size_t windowSize = std::max< size_t >(getScanPool().size(), 1);
+    Vector< Vector< size_t > > chunks;
+    chunks.reserve(windowSize);
+    for (size_t i = 0; i < windowSize; ++i)
+    {
+      chunks.pushBack(Vector< size_t >());
+    }
+    size_t nWindow = 0;
+    for (size_t first = firstSlot; first < nSlots; first += nWindow * SCAN_CHUNK_SIZE_)
+    {
+      nWindow = std::min(std::max< size_t >(nWindow * 2, 1), windowSize);
+      getScanPool().parallelFor(nWindow, [&](size_t i)
+      {
+        size_t begin = std::min(first + i * SCAN_CHUNK_SIZE_, nSlots);
+        chunks[i].clear();
+        filterChunk(*condition, begin, std::min(begin + SCAN_CHUNK_SIZE_, nSlots), chunks[i]);
+      });
+      for (size_t i = 0; i < nWindow; ++i)
+      {
+        for (size_t j = 0; j < chunks[i].size(); ++j)
+        {
+          if (!visitor(RowRef(*this, chunks[i][j])))
+          {
+            return;
+          }
+        }
+      }
+    }
+  }
+
+  bool Table::isIndexed(const Condition& condition) const
+  {
+    if (condition.isCompound())
+    {
+      const Vector< Condition >& operands = condition.getOperands();
+      if (condition.getLogicalOperation() == LOGICAL_NOT)
+      {
+        return false;
+      }
+      bool isConjunction = condition.getLogicalOperation() == LOGICAL_AND;
+      for (size_t i = 0; i < operands.size(); ++i)
+      {
+        if (isIndexed(operands[i]) == isConjunction)
+        {
+          return isConjunction;
+        }
+      }
+      return !isConjunction;
+    }
+    size_t index = condition.getColumnIndex();
+    bool isEquality = condition.getOperation() == EQUAL;
+    return ((index == 0) && isEquality) || (orderedIndexes_.find(index) != orderedIndexes_.cend())
+      || ((indexes_.find(index) != indexes_.cend()) && isEquality);
+  }
+
+  Vector< size_t > Table::findSlots(const Condition& condition) const
+  {
+    if (!isIndexed(condition))
+    {
+      return scanSlots(condition);
+    }
+    Vector< size_t > slots;
+    if (condition.isCompound())
+    {
+      const Vector< Condition >& operands = condition.getOperands();
+      if (condition.getLogicalOperation() == LOGICAL_OR)
+      {
+        slots = findSlots(operands[0]);
+        sortAscending(slots);
+        for (size_t i = 1; i < operands.size(); ++i)
+        {
+          Vector< size_t > other = findSlots(operands[i]);
+          sortAscending(other);
+          uniteSlots(slots, other);
+        }
+        return slots;
+      }
+      size_t first = 0;
+      while (!isIndexed(operands[first]))
+      {
+        ++first;
+      }
+      Vector< size_t > found = findSlots(operands[first]);
+      for (size_t i = 0; i < found.size(); ++i)
+      {
+        bool isMatch = true;
+        for (size_t j = 0; (j < operands.size()) && isMatch; ++j)
+        {
+          isMatch = (j == first) || isSlotMatch(operands[j], found[i]);
+        }
+        if (isMatch)
+        {
+          slots.pushBack(found[i]);
+        }
+      }
+      return slots;
+    }
+    size_t index = condition.getColumnIndex();
+    if (index == 0)
+    {
+      size_t slot = rowSlots_.find(condition.getInteger());
+      if (slot != NO_SLOT)
+      {
+        slots.pushBack(slot);
+      }
+      return slots;
+    }
+    auto orderedIndexIter = orderedIndexes_.find(index);
+    if (orderedIndexIter != orderedIndexes_.cend())
+    {
+      Vector< size_t > ids;
+      (*orderedIndexIter).second.collect(condition, ids);
+      collectSlots(ids, slots);
+      return slots;
+    }
+    const Vector< size_t >* ids = (*indexes_.find(index)).second.find(condition);
+    if (ids)
+    {
+      collectSlots(*ids, slots);
+    }
+    return slots;
+  }
+
+  Vector< size_t > Table::scanSlots(const Condition& condition) const
+  {
+    size_t nSlots = slotsCount();
+    size_t nChunks = (nSlots + SCAN_CHUNK_SIZE_ - 1) / SCAN_CHUNK_SIZE_;
+    Vector< size_t > slots;
+    if (nChunks <= 1)
+    {
+      filterChunk(condition, 0, nSlots, slots);
+      return slots;
+    }
+    Vector< Vector< size_t > > chunks;
+    chunks.reserve(nChunks);
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      chunks.pushBack(Vector< size_t >());
+    }
+    getScanPool().parallelFor(nChunks, [&](size_t i)
+    {
+      size_t begin = i * SCAN_CHUNK_SIZE_;
+      filterChunk(condition, begin, std::min(begin + SCAN_CHUNK_SIZE_, nSlots), chunks[i]);
+    });
+    size_t nFound = 0;
+    for (size_t i = 0; i < nChunks; ++i)
     {
-      std::stoi(value, pos);
+      nFound += chunks[i].size();
     }
-    else if (dataType == babinov::REAL)
+    slots.reserve(nFound);
+    for (size_t i = 0; i < nChunks; ++i)
     {
-      std::stod(value, pos);
+      for (size_t j = 0; j < chunks[i].size(); ++j)
+      {
+        slots.pushBack(chunks[i][j]);
+      }
     }
-    return *pos == value.size();
-  }
-  catch (const std::invalid_argument&)
-  {
-    return false;
+    return slots;
   }
-}
 
-bool isEqual(const std::string& first, const std::string& second, babinov::DataType dataType)
-{
-  try
+  double Table::estimateSelectivity(const Condition& condition) const
   {
-    if (dataType == babinov::PK)
+    size_t nSlots = slotsCount();
+    size_t step = std::max< size_t >(nSlots / SELECTIVITY_SAMPLE_SIZE_, 1);
+    size_t nSampled = 0;
+    size_t nMatched = 0;
+    for (size_t slot = 0; slot < nSlots; slot += step)
     {
-      return std::stoull(first) == std::stoull(first);
+      if (isAlive_[slot])
+      {
+        ++nSampled;
+        nMatched += isSlotMatch(condition, slot);
+      }
     }
-    else if (dataType == babinov::INTEGER)
+    return (nMatched + 0.5) / (nSampled + 1.0);
+  }
+
+  double Table::estimateCost(const Condition& condition, bool isScan) const
+  {
+    if (!condition.isCompound())
     {
-      return std::stoi(first) == std::stoi(second);
+      double cost = isScan ? SCAN_COST : PROBE_COST;
+      return (condition.getDataType() == TEXT) ? cost * TEXT_COST_FACTOR : cost;
     }
-    else if (dataType == babinov::REAL)
+    double cost = 0.0;
+    const Vector< Condition >& operands = condition.getOperands();
+    for (size_t i = 0; i < operands.size(); ++i)
     {
-      return std::stod(first) == std::stod(second);
+      cost += estimateCost(operands[i], isScan);
     }
-    return first == second;
-  }
-  catch (const std::invalid_argument&)
-  {
-    return false;
+    return cost;
   }
-}
 
-namespace babinov
-{
-  bool isCorrectName(const std::string& name)
+  bool Table::isSlotMatch(const Condition& condition, size_t slot) const
   {
-    auto pred = [&](const char ch) -> bool
+    const Vector< Condition >& operands = condition.getOperands();
+    switch (condition.getLogicalOperation())
     {
-      return !((std::isalnum(ch)) || (ch == '_'));
-    };
-    return (std::find_if(name.cbegin(), name.cend(), pred)) == (name.cend());
+    case LOGICAL_AND:
+      for (size_t i = 0; i < operands.size(); ++i)
+      {
+        if (!isSlotMatch(operands[i], slot))
+        {
+          return false;
+        }
+      }
+      return true;
+    case LOGICAL_OR:
+      for (size_t i = 0; i < operands.size(); ++i)
+      {
+        if (isSlotMatch(operands[i], slot))
+        {
+          return true;
+        }
+      }
+      return false;
+    case LOGICAL_NOT:
+      return !isSlotMatch(operands[0], slot);
+    default:
+      return data_[condition.getColumnIndex()].isMatch(slot, condition);
+    }
   }
 
-  Table::Table():
-    columns_(),
-    rows_(),
-    rowIters_(),
-    lastId_(0)
-  {}
-
-  Table::Table(const Vector< Column >& columns):
-    rows_(),
-    rowIters_(),
-    lastId_(0)
+  void Table::filterChunk(const Condition& condition, size_t begin, size_t end, Vector< size_t >& slots) const
   {
-    for (size_t i = 0; i < columns.size(); ++i)
+    if (!condition.isCompound())
     {
-      Column column = columns[i];
-      if ((!isCorrectName(column.first)) || (column.second == PK))
+      data_[condition.getColumnIndex()].filter(condition, isAlive_, begin, end, slots);
+      return;
+    }
+    const Vector< Condition >& operands = condition.getOperands();
+    Vector< size_t > found;
+    filterChunk(operands[0], begin, end, found);
+    if (condition.getLogicalOperation() == LOGICAL_NOT)
+    {
+      size_t pos = 0;
+      for (size_t slot = begin; slot < end; ++slot)
       {
-        throw std::invalid_argument("Invalid columns");
+        if ((pos < found.size()) && (found[pos] == slot))
+        {
+          ++pos;
+        }
+        else if (isAlive_[slot])
+        {
+          slots.pushBack(slot);
+        }
       }
+      return;
     }
-    Vector< Column > tempColumns;
-    tempColumns.pushBack({"id", PK});
-    for (size_t i = 0; i < columns.size(); ++i)
+    for (size_t i = 1; i < operands.size(); ++i)
     {
-      tempColumns.pushBack(columns[i]);
+      if (condition.getLogicalOperation() == LOGICAL_OR)
+      {
+        Vector< size_t > other;
+        filterChunk(operands[i], begin, end, other);
+        uniteSlots(found, other);
+        continue;
+      }
+      size_t nKept = 0;
+      for (size_t j = 0; j < found.size(); ++j)
+      {
+        if (isSlotMatch(operands[i], found[j]))
+        {
+          found[nKept++] = found[j];
+        }
+      }
+      while (found.size() > nKept)
+      {
+        found.popBack();
+      }
     }
-    columns_ = std::move(tempColumns);
-  }
-   
-  Table::Table(const Table& other):
-    columns_(other.columns_),
-    rows_(other.rows_),
-    lastId_(other.lastId_)
-  {
-    for (auto it = rows_.begin(); it != rows_.end(); ++it)
+    slots.reserve(slots.size() + found.size());
+    for (size_t i = 0; i < found.size(); ++i)
     {
-      rowIters_.insert(std::stoull((*it)[0]), it);
+      slots.pushBack(found[i]);
     }
   }
 
-  Table::Table(Table&& other) noexcept:
-    columns_(std::move(other.columns_)),
-    rows_(std::move(other.rows_)),
-    rowIters_(std::move(other.rowIters_)),
-    lastId_(other.lastId_)
-  {
-    other.lastId_ = 0;
-  }
-
-  Table& Table::operator=(const Table& other)
+  void Table::checkAggregates(const Vector< Aggregate >& aggregates) const
   {
-    if (this != &other)
+    for (size_t i = 0; i < aggregates.size(); ++i)
     {
-      Table temp(other);
-      swap(temp);
+      if (aggregates[i].columnIndex >= columns_.size())
+      {
+        throw std::out_of_range("Column doesn't exist");
+      }
+      if ((aggregates[i].function != COUNT) && (columns_[aggregates[i].columnIndex].second == TEXT))
+      {
+        throw std::invalid_argument("Cannot aggregate text column");
+      }
     }
-    return *this;
   }
 
-  Table& Table::operator=(Table&& other) noexcept
+  void Table::collectChunk(const Condition* condition, size_t begin, size_t end, Vector< size_t >& slots) const
   {
-    if (this != &other)
+    if (condition)
     {
-      Table temp(std::move(other));
-      swap(temp);
+      filterChunk(*condition, begin, end, slots);
+      return;
+    }
+    slots.reserve(slots.size() + end - begin);
+    for (size_t slot = begin; slot < end; ++slot)
+    {
+      if (isAlive_[slot])
+      {
+        slots.pushBack(slot);
+      }
     }
-    return *this;
   }
 
-  bool Table::isCorrectRow(const Row& row) const
+  Vector< Accumulator > Table::accumulate(const Vector< Aggregate >& aggregates, const Condition* condition) const
   {
-    if (row.size() != (columns_.size() - 1))
+    checkAggregates(aggregates);
+    Vector< Accumulator > result;
+    for (size_t i = 0; i < aggregates.size(); ++i)
     {
-      return false;
+      result.pushBack(Accumulator());
     }
-    for (size_t i = 0; i < row.size(); ++i)
+    if (condition && isIndexed(*condition))
+    {
+      accumulateSlots(aggregates, findSlots(*condition), result);
+      return result;
+    }
+    size_t nSlots = slotsCount();
+    size_t nChunks = (nSlots + SCAN_CHUNK_SIZE_ - 1) / SCAN_CHUNK_SIZE_;
+    Vector< Vector< Accumulator > > chunks;
+    chunks.reserve(nChunks);
+    for (size_t i = 0; i < nChunks; ++i)
     {
-      if (!isCorrectValue(row[i], columns_[i + 1].second))
+      chunks.pushBack(result);
+    }
+    getScanPool().parallelFor(nChunks, [&](size_t i)
+    {
+      size_t begin = i * SCAN_CHUNK_SIZE_;
+      Vector< size_t > slots;
+      collectChunk(condition, begin, std::min(begin + SCAN_CHUNK_SIZE_, nSlots), slots);
+      accumulateSlots(aggregates, slots, chunks[i]);
+    });
+    for (size_t i = 0; i < nChunks; ++i)
+    {
+      for (size_t j = 0; j < result.size(); ++j)
       {
-        return false;
+        result[j].merge(chunks[i][j]);
       }
     }
-    return true;
-  }
-
-  const Vector< Table::Column >& Table::getColumns() const
-  {
-    return columns_;
+    return result;
   }
 
-  const List< Table::Row >& Table::getRows() const
+  void Table::accumulateSlots(const Vector< Aggregate >& aggregates, const Vector< size_t >& slots,
+    Vector< Accumulator >& accumulators) const
   {
-    return rows_;
+    for (size_t i = 0; i < aggregates.size(); ++i)
+    {
+      if (aggregates[i].function == COUNT)
+      {
+        accumulators[i].count += slots.size();
+      }
+      else
+      {
+        data_[aggregates[i].columnIndex].accumulate(slots, accumulators[i]);
+      }
+    }
   }
 
-  size_t Table::getColumnIndex(const std::string& columnName) const
+  Vector< Table::Group > Table::group(size_t columnIndex, const Vector< Aggregate >& aggregates,
+    const Condition* condition) const
   {
-    size_t index = 0;
-    for (; (index < columns_.size()) && (columns_[index].first != columnName); ++index) {}
-    if (index == columns_.size())
+    if (columnIndex >= columns_.size())
     {
       throw std::out_of_range("Column doesn't exist");
     }
-    return index;
-  }
-
-  void Table::insert(const Row& row)
-  {
-    if (!isCorrectRow(row))
+    checkAggregates(aggregates);
+    const ColumnStore& column = data_[columnIndex];
+    if (column.getDataType() == TEXT)
     {
-      throw std::invalid_argument("Invalid row");
+      auto getKey = [&column](size_t slot)
+      {
+        return column.getText(slot);
+      };
+      return groupByKey< std::string_view >(getKey, columnIndex, aggregates, condition);
     }
-    size_t pk = lastId_ + 1;
-    Row processed;
-    processed.pushBack(std::to_string(pk));
-    for (size_t i = 0; i < row.size(); ++i)
+    else if (column.getDataType() == REAL)
     {
-      processed.pushBack(row[i]);
+      auto getKey = [&column](size_t slot)
+      {
+        return column.getReal(slot);
+      };
+      return groupByKey< double >(getKey, columnIndex, aggregates, condition);
     }
-    rows_.pushBack(std::move(processed));
-    auto iter = std::prev(rows_.end());
-    rowIters_[pk] = iter;
-    ++lastId_;
+    auto getKey = [&column](size_t slot)
+    {
+      return column.getInteger(slot);
+    };
+    return groupByKey< long long >(getKey, columnIndex, aggregates, condition);
   }
 
-  Vector< Table::Row > Table::select(const std::string& columnName, const std::string& value) const
+  template< class Key, class Getter >
+  Vector< Table::Group > Table::groupByKey(Getter getKey, size_t columnIndex, const Vector< Aggregate >& aggregates,
+    const Condition* condition) const
   {
-    size_t index = getColumnIndex(columnName);
-    DataType dataType = columns_[index].second;
-    if (!isCorrectValue(value, dataType))
+    Vector< size_t > indexedSlots;
+    bool isIndexedScan = condition && isIndexed(*condition);
+    if (isIndexedScan)
     {
-      throw std::invalid_argument("Invalid value");
+      indexedSlots = findSlots(*condition);
     }
-    Vector< Row > result;
-    if (columnName == "id")
+    size_t nSlots = slotsCount();
+    size_t nParts = isIndexedScan ? 1 : std::min(std::max< size_t >(getScanPool().size(), 1),
+      (nSlots + SCAN_CHUNK_SIZE_ - 1) / SCAN_CHUNK_SIZE_);
+    Vector< PartialGroups< Key > > parts;
+    for (size_t i = 0; i < std::max< size_t >(nParts, 1); ++i)
+    {
+      parts.pushBack(PartialGroups< Key >(aggregates.size()));
+    }
+    auto groupPart = [&](size_t part)
     {
-      size_t pk = std::stoull(value);
-      if (rowIters_.find(pk) != rowIters_.cend())
+      PartialGroups< Key >& partial = parts[part];
+      Vector< size_t > slots;
+      Vector< size_t > groups;
+      size_t partEnd = nSlots * (part + 1) / nParts;
+      for (size_t begin = nSlots * part / nParts; begin < partEnd; begin += SCAN_CHUNK_SIZE_)
       {
-        result.pushBack(*rowIters_.at(pk));
+        slots.clear();
+        collectChunk(condition, begin, std::min(begin + SCAN_CHUNK_SIZE_, partEnd), slots);
+        partial.add(slots, getKey, groups);
+        partial.accumulate(aggregates, data_, slots, groups);
       }
-      return result;
+    };
+    if (isIndexedScan)
+    {
+      Vector< size_t > groups;
+      parts[0].add(indexedSlots, getKey, groups);
+      parts[0].accumulate(aggregates, data_, indexedSlots, groups);
+    }
+    else if (nParts)
+    {
+      getScanPool().parallelFor(nParts, groupPart);
     }
-    for (auto it = rows_.begin(); it != rows_.end(); ++it)
+    for (size_t i = 1; i < parts.size(); ++i)
     {
-      if (isEqual((*it)[index], value, dataType))
+      parts[0].merge(parts[i]);
+    }
+    Vector< Group > result;
+    result.reserve(parts[0].keys.size());
+    for (size_t i = 0; i < parts[0].keys.size(); ++i)
+    {
+      Group group{ data_[columnIndex].getAsString(parts[0].firstSlots[i]), Vector< Accumulator >() };
+      for (size_t j = 0; j < aggregates.size(); ++j)
       {
-        result.pushBack(*it);
+        group.accumulators.pushBack(parts[0].accumulators[j][i]);
       }
+      result.pushBack(std::move(group));
     }
     return result;
   }
 
-  bool Table::update(size_t rowId, const std::string& columnName, const std::string& value)
+  void Table::collectSlots(const Vector< size_t >& ids, Vector< size_t >& slots) const
   {
-    if (columnName == "id")
+    slots.reserve(slots.size() + ids.size());
+    for (size_t i = 0; i < ids.size(); ++i)
     {
-      throw std::logic_error("Cannot update id field");
+      slots.pushBack(rowSlots_.find(ids[i]));
     }
-    size_t index = getColumnIndex(columnName);
-    if (!isCorrectValue(value, columns_[index].second))
+    std::sort(slots.data(), slots.data() + slots.size());
+  }
+
+  void Table::pushSlot(const Row& row)
+  {
+    size_t slot = slotsCount();
+    for (size_t i = 0; i < data_.size(); ++i)
     {
-      throw std::invalid_argument("Invalid value");
+      data_[i].pushBack(row[i]);
     }
-    try
+    isAlive_.pushBack(true);
+    size_t id = data_[0].getInteger(slot);
+    rowSlots_.insert(id, slot);
+    trackIdOrder(slot);
+    for (auto it = indexes_.begin(); it != indexes_.end(); ++it)
     {
-      (*rowIters_.at(rowId))[index] = value;
-      return true;
+      (*it).second.insert(data_[(*it).first], slot, id);
     }
-    catch (const std::out_of_range&)
+    for (auto it = orderedIndexes_.begin(); it != orderedIndexes_.end(); ++it)
     {
-      return false;
+      (*it).second.insert(data_[(*it).first], slot, id);
     }
   }
 
-  bool Table::del(const std::string& columnName, const std::string& value)
+  void Table::trackIdOrder(size_t slot) noexcept
   {
-    size_t index = getColumnIndex(columnName);
-    DataType dataType = columns_[index].second;
-    if (!isCorrectValue(value, dataType))
-    {
-      throw std::invalid_argument("Invalid value");
-    }
-    if (columnName == "id")
+    isIdOrdered_ = isIdOrdered_ && ((!slot) || (data_[0].getInteger(slot - 1) < data_[0].getInteger(slot)));
+  }
+
+  void Table::eraseSlot(size_t slot)
+  {
+    size_t id = data_[0].getInteger(slot);
+    for (auto it = indexes_.begin(); it != indexes_.end(); ++it)
     {
-      size_t pk = std::stoull(value);
-      if (rowIters_.find(pk) != rowIters_.end())
-      {
-        rows_.erase(rowIters_[pk]);
-        rowIters_.erase(pk);
-        return true;
-      }
-      return false;
+      (*it).second.erase(data_[(*it).first], slot, id);
     }
-    bool isDeleted = false;
-    auto it = rows_.begin();
-    while (it != rows_.end())
+    for (auto it = orderedIndexes_.begin(); it != orderedIndexes_.end(); ++it)
     {
-      auto temp = it;
-      ++it;
-      if (isEqual((*temp)[index], value, dataType))
-      {
-        size_t pk = std::stoull((*temp)[0]);
-        rows_.erase(temp);
-        rowIters_.erase(pk);
-        isDeleted = true;
-      }
+      (*it).second.erase(data_[(*it).first], slot, id);
     }
-    return isDeleted;
+    rowSlots_.erase(id);
+    isAlive_[slot] = false;
+    ++nDeleted_;
   }
 
-  void Table::swap(Table& other) noexcept
-  {
-    std::swap(columns_, other.columns_);
-    std::swap(rows_, other.rows_);
-    std::swap(rowIters_, other.rowIters_);
-    std::swap(lastId_, other.lastId_);
-  }
-
-  void Table::clear() noexcept
+  void Table::compact()
   {
-    rows_.clear();
-    rowIters_.clear();
-    lastId_ = 0;
+    if ((nDeleted_ * 2) <= slotsCount())
+    {
+      return;
+    }
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      data_[i].compact(isAlive_);
+    }
+    Vector< bool > isAlive;
+    rowSlots_.clear();
+    isIdOrdered_ = true;
+    const ColumnStore& ids = data_[0];
+    for (size_t slot = 0; slot < ids.size(); ++slot)
+    {
+      isAlive.pushBack(true);
+      rowSlots_.insert(ids.getInteger(slot), slot);
+      trackIdOrder(slot);
+    }
+    isAlive_ = std::move(isAlive);
+    nDeleted_ = 0;
   }
 
   std::istream& operator>>(std::istream& in, Table::Column& column)
@@ -310,9 +1529,10 @@ namespace babinov
     std::string dataType;
     std::getline(in, column.first, ':');
     in >> dataType;
-    if (DATA_TYPES_FROM_STR.find(dataType) != DATA_TYPES_FROM_STR.cend())
+    const DataType* desired = DATA_TYPES_FROM_STR.findValue(dataType);
+    if (desired)
     {
-      column.second = DATA_TYPES_FROM_STR.at(dataType);
+      column.second = *desired;
     }
     else
     {
@@ -331,7 +1551,6 @@ namespace babinov
     using del = CharDelimiterI;
     std::string data;
     in >> del::insensitive('[') >> data;
-    size_t pk = std::stoull(data);
 
     Table::Row row;
     row.pushBack(data);
@@ -351,12 +1570,17 @@ namespace babinov
     }
     in >> del::insensitive(']');
 
+    for (size_t i = 0; in && (i < columns_.size()); ++i)
+    {
+      if (checkValue(row[i], columns_[i].second) != PARSE_OK)
+      {
+        in.setstate(std::ios::failbit);
+      }
+    }
     if (in)
     {
-      rows_.pushBack(std::move(row));
-      auto iter = std::prev(rows_.end());
-      rowIters_[pk] = iter;
-      lastId_ = std::max(lastId_, pk);
+      pushSlot(row);
+      lastId_ = std::max< size_t >(lastId_, data_[0].getInteger(slotsCount() - 1));
     }
   }
 
@@ -428,9 +1652,143 @@ namespace babinov
     out << ']';
   }
 
-  void Table::printRow(std::ostream& out, List< Row >::Iterator iter) const
+  void Table::printRow(std::ostream& out, const Table::RowRef& row) const
+  {
+    std::ostream::sentry sentry(out);
+    if (!sentry)
+    {
+      return;
+    }
+    row.print(out);
+  }
+
+  void Table::printRow(std::ostream& out, const Table::RowRef& row, const Projection& columns) const
+  {
+    std::ostream::sentry sentry(out);
+    if (!sentry)
+    {
+      return;
+    }
+    row.print(out, columns);
+  }
+
+  void Table::printSlot(std::ostream& out, size_t slot) const
+  {
+    out << "[ ";
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      data_[i].print(out, slot);
+      out << ' ';
+    }
+    out << ']';
+  }
+
+  void Table::printSlot(std::ostream& out, size_t slot, const Projection& columns) const
+  {
+    out << "[ ";
+    for (size_t i = 0; i < columns.size(); ++i)
+    {
+      data_[columns[i]].print(out, slot);
+      out << ' ';
+    }
+    out << ']';
+  }
+
+  void Table::printRows(std::ostream& out) const
+  {
+    std::ostream::sentry sentry(out);
+    if (!sentry)
+    {
+      return;
+    }
+    for (size_t slot = 0; slot < slotsCount(); ++slot)
+    {
+      if (isAlive_[slot])
+      {
+        out << '\n';
+        printSlot(out, slot);
+      }
+    }
+  }
+
+  void Table::writeSnapshot(std::ostream& out) const
+  {
+    std::ostringstream header;
+    header.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    writeRaw(header, SNAPSHOT_VERSION);
+    writeRaw(header, SNAPSHOT_BYTE_ORDER);
+    writeRaw< uint64_t >(header, columns_.size());
+    writeRaw< uint64_t >(header, size());
+    writeRaw< uint64_t >(header, lastId_);
+    for (size_t i = 0; i < columns_.size(); ++i)
+    {
+      writeRaw< uint8_t >(header, columns_[i].second);
+      writeRaw< uint32_t >(header, columns_[i].first.size());
+      header << columns_[i].first;
+    }
+    std::string bytes = header.str();
+    out.write(bytes.data(), bytes.size());
+    writeRaw< uint64_t >(out, checksum(bytes.data(), bytes.size()));
+    for (size_t i = 0; i < data_.size(); ++i)
+    {
+      data_[i].writeSnapshot(out, isAlive_);
+    }
+  }
+
+  void Table::readSnapshot(const char* data, size_t size)
   {
-    printRow(out, *iter);
+    SnapshotReader reader(data, size);
+    const char* magic = nullptr;
+    uint32_t version = 0;
+    uint32_t byteOrder = 0;
+    uint64_t nColumns = 0;
+    uint64_t nRows = 0;
+    uint64_t lastId = 0;
+    bool isCorrect = reader.readBytes(magic, sizeof(SNAPSHOT_MAGIC)) && reader.read(version)
+      && reader.read(byteOrder) && reader.read(nColumns) && reader.read(nRows) && reader.read(lastId);
+    isCorrect = isCorrect && (!std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)))
+      && (version == SNAPSHOT_VERSION) && (byteOrder == SNAPSHOT_BYTE_ORDER) && nColumns && (nColumns <= size);
+    Vector< Column > columns;
+    for (size_t i = 0; isCorrect && (i < nColumns); ++i)
+    {
+      uint8_t dataType = 0;
+      uint32_t nameSize = 0;
+      const char* name = nullptr;
+      isCorrect = reader.read(dataType) && reader.read(nameSize) && reader.readBytes(name, nameSize)
+        && (dataType <= TEXT) && ((dataType == PK) == (i == 0));
+      if (isCorrect && i)
+      {
+        columns.pushBack({ std::string(name, nameSize), static_cast< DataType >(dataType) });
+      }
+    }
+    size_t headerSize = reader.position() - data;
+    uint64_t headerChecksum = 0;
+    if ((!isCorrect) || (!reader.read(headerChecksum)) || (headerChecksum != checksum(data, headerSize)))
+    {
+      throw std::invalid_argument("Invalid snapshot");
+    }
+    Table table(columns);
+    for (size_t i = 0; i < table.data_.size(); ++i)
+    {
+      if (!table.data_[i].readSnapshot(reader, nRows))
+      {
+        throw std::invalid_argument("Invalid snapshot");
+      }
+    }
+    table.isAlive_.reserve(nRows);
+    for (size_t slot = 0; slot < nRows; ++slot)
+    {
+      long long id = table.data_[0].getInteger(slot);
+      if ((id < 0) || (static_cast< uint64_t >(id) > lastId) || (table.rowSlots_.find(id) != NO_SLOT))
+      {
+        throw std::invalid_argument("Invalid snapshot");
+      }
+      table.isAlive_.pushBack(true);
+      table.rowSlots_.insert(id, slot);
+      table.trackIdOrder(slot);
+    }
+    table.lastId_ = lastId;
+    swap(table);
   }
 
   std::ostream& operator<<(std::ostream& out, const Table& table)
@@ -446,12 +1804,7 @@ namespace babinov
     {
       out << columns[i] << ' ';
     }
-    const List< Table::Row >& rows = table.getRows();
-    for (auto it = rows.begin(); it != rows.end(); ++it)
-    {
-      out << '\n';
-      table.printRow(out, it);
-    }
+    table.printRows(out);
     return out;
   }
 }
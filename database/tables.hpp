@@ -1,34 +1,34 @@
 #ifndef TABLES_HPP
 #define TABLES_HPP
+#include <functional>
 #include <iostream>
 #include <string>
 
 #include "vector.hpp"
-#include "list.hpp"
-#include "hash_table.hpp"
+#include "hash_policies.hpp"
+#include "aggregate.hpp"
+#include "data_types.hpp"
+#include "column_store.hpp"
+#include "condition.hpp"
+#include "hash_index.hpp"
+#include "id_directory.hpp"
+#include "ordered_index.hpp"
 
 namespace babinov
 {
-  enum DataType
+  enum IndexType
   {
-    PK,
-    INTEGER,
-    REAL,
-    TEXT
+    HASH_INDEX,
+    ORDERED_INDEX
   };
 
-  const HashTable< DataType, std::string > DATA_TYPES_AS_STR = {
-    {PK, "PK"},
-    {INTEGER, "INTEGER"},
-    {REAL, "REAL"},
-    {TEXT, "TEXT"}
-  };
-
-  const HashTable< std::string, DataType > DATA_TYPES_FROM_STR = {
-    {"PK", PK},
-    {"INTEGER", INTEGER},
-    {"REAL", REAL},
-    {"TEXT", TEXT}
+  enum AccessMethod
+  {
+    FULL_SCAN,
+    ID_LOOKUP,
+    HASH_INDEX_LOOKUP,
+    ORDERED_INDEX_RANGE,
+    INDEX_UNION
   };
 
   class Table
@@ -36,6 +36,46 @@ namespace babinov
   public:
     using Row = Vector< std::string >;
     using Column = std::pair< std::string, DataType >;
+    using Projection = Vector< size_t >;
+
+    class RowRef
+    {
+    public:
+      RowRef(const Table& table, size_t slot) noexcept;
+
+      size_t getSlot() const noexcept;
+      size_t getId() const;
+      const ColumnStore& getColumn(size_t columnIndex) const;
+      std::string getAsString(size_t columnIndex) const;
+      Row toRow() const;
+      Row toRow(const Projection& columns) const;
+      void print(std::ostream& out) const;
+      void print(std::ostream& out, const Projection& columns) const;
+
+    private:
+      const Table* table_;
+      size_t slot_;
+    };
+    using RowVisitor = std::function< bool(const RowRef&) >;
+
+    struct SortOrder
+    {
+      size_t columnIndex;
+      bool isDescending;
+    };
+
+    struct Group
+    {
+      std::string key;
+      Vector< Accumulator > accumulators;
+    };
+
+    struct AccessPath
+    {
+      AccessMethod method;
+      size_t columnIndex;
+      double estimatedRows;
+    };
 
     Table();
     explicit Table(const Vector< Column >& columns);
@@ -47,25 +87,105 @@ namespace babinov
 
     bool isCorrectRow(const Row& row) const;
     const Vector< Column >& getColumns() const;
-    const List< Row >& getRows() const;
     size_t getColumnIndex(const std::string& columnName) const;
+    const ColumnStore& getColumnData(size_t columnIndex) const;
+    size_t size() const noexcept;
+    size_t getLastId() const noexcept;
+    bool hasRow(size_t rowId) const noexcept;
+    Condition makeCondition(const std::string& columnName, const std::string& value) const;
+    Condition makeCondition(const std::string& columnName, CompareOperation operation,
+      const std::string& value, const std::string& upperValue = std::string()) const;
+    Condition planCondition(const Condition& condition) const;
+    AccessPath explain(const Condition& condition) const;
+    Projection makeProjection(const Vector< std::string >& columnNames) const;
 
     void readRow(std::istream& in);
-    void printRow(std::ostream& out, List< Row >::Iterator iter) const;
     void printRow(std::ostream& out, const Row& row) const;
+    void printRow(std::ostream& out, const RowRef& row) const;
+    void printRow(std::ostream& out, const RowRef& row, const Projection& columns) const;
+    void printRows(std::ostream& out) const;
+    void writeSnapshot(std::ostream& out) const;
+    void readSnapshot(const char* data, size_t size);
 
     void insert(const Row& row);
+    void appendRows(Vector< ColumnStore >&& rows);
+    size_t encodeTexts();
+    void advanceLastId(size_t lastId) noexcept;
     Vector< Row > select(const std::string& columnName, const std::string& value) const;
+    Vector< Row > select(const Condition& condition) const;
+    Vector< Row > select(const Condition& condition, const Projection& columns) const;
+    void forEach(const RowVisitor& visitor) const;
+    void forEach(const Condition& condition, const RowVisitor& visitor) const;
+    void forEachAfter(size_t rowId, const RowVisitor& visitor) const;
+    void forEachAfter(size_t rowId, const Condition& condition, const RowVisitor& visitor) const;
+    void forEachSorted(const SortOrder& order, size_t limit, const RowVisitor& visitor) const;
+    void forEachSorted(const SortOrder& order, size_t limit, const Projection& columns,
+      const RowVisitor& visitor) const;
+    void forEachSorted(const Condition& condition, const SortOrder& order, size_t limit,
+      const RowVisitor& visitor) const;
+    void forEachSorted(const Condition& condition, const SortOrder& order, size_t limit, const Projection& columns,
+      const RowVisitor& visitor) const;
+    size_t count(const Condition& condition) const;
+    Vector< Accumulator > aggregate(const Vector< Aggregate >& aggregates) const;
+    Vector< Accumulator > aggregate(const Vector< Aggregate >& aggregates, const Condition& condition) const;
+    Vector< Group > groupBy(size_t columnIndex, const Vector< Aggregate >& aggregates) const;
+    Vector< Group > groupBy(size_t columnIndex, const Vector< Aggregate >& aggregates, const Condition& condition) const;
     bool update(size_t rowId, const std::string& columnName, const std::string& value);
+    size_t update(const Condition& condition, const std::string& columnName, const std::string& value);
     bool del(const std::string& columnName, const std::string& value);
+    bool del(const Condition& condition);
+    void createIndex(const std::string& columnName, IndexType indexType = HASH_INDEX);
+    bool dropIndex(const std::string& columnName);
+    bool hasIndex(size_t columnIndex) const;
     void swap(Table& other) noexcept;
     void clear() noexcept;
 
   private:
+    static const size_t SCAN_CHUNK_SIZE_ = 1 << 16;
+    static const size_t PREFETCH_DISTANCE_ = 16;
+    static const size_t SELECTIVITY_SAMPLE_SIZE_ = 256;
+
     Vector< Column > columns_;
-    List< Row > rows_;
-    HashTable< size_t, List< Row >::Iterator > rowIters_;
+    Vector< ColumnStore > data_;
+    Vector< bool > isAlive_;
+    IdDirectory rowSlots_;
+    HashMap< size_t, HashIndex > indexes_;
+    HashMap< size_t, OrderedIndex > orderedIndexes_;
+    size_t nDeleted_;
     size_t lastId_;
+    bool isIdOrdered_;
+
+    size_t slotsCount() const noexcept;
+    Row getRow(size_t slot) const;
+    Row getRow(size_t slot, const Projection& columns) const;
+    Vector< Row > collectRows(const Vector< size_t >& slots, const Projection* columns) const;
+    bool isIndexed(const Condition& condition) const;
+    Vector< size_t > findSlots(const Condition& condition) const;
+    Vector< size_t > scanSlots(const Condition& condition) const;
+    size_t findResumeSlot(size_t rowId) const;
+    void scanFrom(const Condition* condition, size_t firstSlot, const RowVisitor& visitor) const;
+    double estimateSelectivity(const Condition& condition) const;
+    double estimateCost(const Condition& condition, bool isScan) const;
+    bool isSlotMatch(const Condition& condition, size_t slot) const;
+    void filterChunk(const Condition& condition, size_t begin, size_t end, Vector< size_t >& slots) const;
+    void collectSlots(const Vector< size_t >& ids, Vector< size_t >& slots) const;
+    void checkAggregates(const Vector< Aggregate >& aggregates) const;
+    void collectChunk(const Condition* condition, size_t begin, size_t end, Vector< size_t >& slots) const;
+    Vector< Accumulator > accumulate(const Vector< Aggregate >& aggregates, const Condition* condition) const;
+    Vector< Group > group(size_t columnIndex, const Vector< Aggregate >& aggregates, const Condition* condition) const;
+    template< class Key, class Getter >
+    Vector< Group > groupByKey(Getter getKey, size_t columnIndex, const Vector< Aggregate >& aggregates,
+      const Condition* condition) const;
+    void accumulateSlots(const Vector< Aggregate >& aggregates, const Vector< size_t >& slots,
+      Vector< Accumulator >& accumulators) const;
+    void printSlot(std::ostream& out, size_t slot) const;
+    void printSlot(std::ostream& out, size_t slot, const Projection& columns) const;
+    void visitSorted(const Condition* condition, const SortOrder& order, size_t limit, const Projection* columns,
+      const RowVisitor& visitor) const;
+    void pushSlot(const Row& row);
+    void trackIdOrder(size_t slot) noexcept;
+    void eraseSlot(size_t slot);
+    void compact();
   };
   std::istream& operator>>(std::istream& in, Table& table);
   std::istream& operator>>(std::istream& in, Table::Column& column);
@@ -0,0 +1,161 @@
+#include "thread_pool.hpp"
+#include <algorithm>
+#include <utility>
+
+thread_local const babinov::ThreadPool* currentPool = nullptr;
+
+struct PoolScope
+{
+  explicit PoolScope(const babinov::ThreadPool* pool):
+    previous(currentPool)
+  {
+    currentPool = pool;
+  }
+  ~PoolScope()
+  {
+    currentPool = previous;
+  }
+  const babinov::ThreadPool* previous;
+};
+
+namespace babinov
+{
+  ThreadPool::ThreadPool(size_t nThreads):
+    workers_(),
+    runMutex_(),
+    mutex_(),
+    wakeUp_(),
+    done_(),
+    task_(nullptr),
+    nTasks_(0),
+    nextTask_(0),
+    nFinished_(0),
+    generation_(0),
+    isStopped_(false),
+    error_()
+  {
+    start(std::max< size_t >(nThreads, 1) - 1);
+  }
+
+  ThreadPool::~ThreadPool()
+  {
+    stop();
+  }
+
+  size_t ThreadPool::size() const noexcept
+  {
+    return workers_.size() + 1;
+  }
+
+  void ThreadPool::resize(size_t nThreads)
+  {
+    std::lock_guard< std::mutex > runLock(runMutex_);
+    stop();
+    start(std::max< size_t >(nThreads, 1) - 1);
+  }
+
+  void ThreadPool::parallelFor(size_t nTasks, const std::function< void(size_t) >& task)
+  {
+    if ((nTasks <= 1) || workers_.isEmpty() || (currentPool == this))
+    {
+      for (size_t i = 0; i < nTasks; ++i)
+      {
+        task(i);
+      }
+      return;
+    }
+    std::lock_guard< std::mutex > runLock(runMutex_);
+    PoolScope scope(this);
+    std::unique_lock< std::mutex > lock(mutex_);
+    task_ = &task;
+    nTasks_ = nTasks;
+    nextTask_ = 0;
+    nFinished_ = 0;
+    error_ = nullptr;
+    ++generation_;
+    wakeUp_.notify_all();
+    runTasks(lock);
+    done_.wait(lock, [this]() { return nFinished_ == nTasks_; });
+    task_ = nullptr;
+    std::exception_ptr error = std::move(error_);
+    error_ = nullptr;
+    lock.unlock();
+    if (error)
+    {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void ThreadPool::start(size_t nWorkers)
+  {
+    isStopped_ = false;
+    for (size_t i = 0; i < nWorkers; ++i)
+    {
+      workers_.pushBack(std::thread(&ThreadPool::runWorker, this));
+    }
+  }
+
+  void ThreadPool::stop() noexcept
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      isStopped_ = true;
+    }
+    wakeUp_.notify_all();
+    for (size_t i = 0; i < workers_.size(); ++i)
+    {
+      workers_[i].join();
+    }
+    workers_.clear();
+  }
+
+  void ThreadPool::runWorker()
+  {
+    PoolScope scope(this);
+    std::unique_lock< std::mutex > lock(mutex_);
+    size_t seenGeneration = generation_;
+    while (true)
+    {
+      wakeUp_.wait(lock, [&]() { return isStopped_ || (generation_ != seenGeneration); });
+      if (isStopped_)
+      {
+        return;
+      }
+      seenGeneration = generation_;
+      runTasks(lock);
+    }
+  }
+
+  void ThreadPool::runTasks(std::unique_lock< std::mutex >& lock)
+  {
+    while (task_ && (nextTask_ < nTasks_))
+    {
+      size_t current = nextTask_++;
+      const std::function< void(size_t) >* task = task_;
+      lock.unlock();
+      try
+      {
+        (*task)(current);
+        lock.lock();
+      }
+      catch (...)
+      {
+        lock.lock();
+        if (!error_)
+        {
+          error_ = std::current_exception();
+        }
+      }
+      if (++nFinished_ == nTasks_)
+      {
+        done_.notify_one();
+      }
+    }
+  }
+
+  ThreadPool& getScanPool()
+  {
+    static ThreadPool pool(std::thread::hardware_concurrency());
+    return pool;
+  }
+}
@@ -0,0 +1,48 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+#include "vector.hpp"
+
+namespace babinov
+{
+  class ThreadPool
+  {
+  public:
+    explicit ThreadPool(size_t nThreads);
+    ThreadPool(const ThreadPool&) = delete;
+    ~ThreadPool();
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const noexcept;
+    void resize(size_t nThreads);
+    void parallelFor(size_t nTasks, const std::function< void(size_t) >& task);
+
+  private:
+    Vector< std::thread > workers_;
+    std::mutex runMutex_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    std::condition_variable done_;
+    const std::function< void(size_t) >* task_;
+    size_t nTasks_;
+    size_t nextTask_;
+    size_t nFinished_;
+    size_t generation_;
+    bool isStopped_;
+    std::exception_ptr error_;
+
+    void start(size_t nWorkers);
+    void stop() noexcept;
+    void runWorker();
+    void runTasks(std::unique_lock< std::mutex >& lock);
+  };
+
+  ThreadPool& getScanPool();
+}
+
+#endif
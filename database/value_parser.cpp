@@ -0,0 +1,40 @@
+#include "value_parser.hpp"
+
+namespace babinov
+{
+  ParseStatus parseInteger(std::string_view token, DataType dataType, long long& value) noexcept
+  {
+    if (dataType == INTEGER)
+    {
+      int integer = 0;
+      ParseStatus status = parseNumber(token, integer);
+      value = integer;
+      return status;
+    }
+    if (!token.empty() && (token[0] == '-'))
+    {
+      return PARSE_INVALID;
+    }
+    return parseNumber(token, value);
+  }
+
+  ParseStatus parseReal(std::string_view token, double& value) noexcept
+  {
+    return parseNumber(token, value);
+  }
+
+  ParseStatus checkValue(std::string_view token, DataType dataType) noexcept
+  {
+    if (dataType == TEXT)
+    {
+      return PARSE_OK;
+    }
+    if (dataType == REAL)
+    {
+      double real = 0.0;
+      return parseReal(token, real);
+    }
+    long long integer = 0;
+    return parseInteger(token, dataType, integer);
+  }
+}
@@ -0,0 +1,45 @@
+#ifndef VALUE_PARSER_HPP
+#define VALUE_PARSER_HPP
+#include <charconv>
+#include <string_view>
+
+#include "data_types.hpp"
+
+namespace babinov
+{
+  enum ParseStatus
+  {
+    PARSE_OK,
+    PARSE_INVALID,
+    PARSE_OUT_OF_RANGE
+  };
+
+  template< class T >
+  ParseStatus parseNumber(std::string_view token, T& value) noexcept;
+  ParseStatus parseInteger(std::string_view token, DataType dataType, long long& value) noexcept;
+  ParseStatus parseReal(std::string_view token, double& value) noexcept;
+  ParseStatus checkValue(std::string_view token, DataType dataType) noexcept;
+
+  template< class T >
+  ParseStatus parseNumber(std::string_view token, T& value) noexcept
+  {
+    const char* begin = token.data();
+    const char* end = begin + token.size();
+    if ((begin != end) && (*begin == '+'))
+    {
+      ++begin;
+      if ((begin != end) && (*begin == '-'))
+      {
+        return PARSE_INVALID;
+      }
+    }
+    std::from_chars_result result = std::from_chars(begin, end, value);
+    if (result.ec == std::errc::result_out_of_range)
+    {
+      return PARSE_OUT_OF_RANGE;
+    }
+    return ((result.ec == std::errc()) && (result.ptr == end)) ? PARSE_OK : PARSE_INVALID;
+  }
+}
+
+#endif
@@ -0,0 +1,602 @@
+#include "write_ahead_log.hpp"
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#define LOG_USE_FSYNC
+#endif
+
+#include "snapshot.hpp"
+
+const char LOG_MAGIC[8] = { 'B', 'T', 'B', 'L', 'W', 'A', 'L', '1' };
+const size_t MAX_CONDITION_DEPTH = 64;
+const size_t FINGERPRINT_BLOCK_SIZE = size_t(1) << 20;
+
+enum LogRecordType : uint8_t
+{
+  LOG_INSERT = 1,
+  LOG_UPDATE,
+  LOG_DELETE,
+  LOG_CLEAR,
+  LOG_DELETE_WHERE,
+  LOG_UPDATE_WHERE,
+  LOG_CHECKPOINT
+};
+
+template< class T >
+void appendRaw(std::string& dest, const T& value)
+{
+  dest.append(reinterpret_cast< const char* >(&value), sizeof(T));
+}
+
+void appendString(std::string& dest, const std::string& value)
+{
+  appendRaw< uint32_t >(dest, value.size());
+  dest.append(value);
+}
+
+bool readString(babinov::SnapshotReader& reader, std::string& value)
+{
+  uint32_t size = 0;
+  const char* bytes = nullptr;
+  if ((!reader.read(size)) || (!reader.readBytes(bytes, size)))
+  {
+    return false;
+  }
+  value.assign(bytes, size);
+  return true;
+}
+
+std::string formatBound(const babinov::Condition& condition, bool isUpper)
+{
+  if (condition.getDataType() == babinov::TEXT)
+  {
+    return isUpper ? condition.getUpperText() : condition.getText();
+  }
+  else if (condition.getDataType() == babinov::REAL)
+  {
+    char buffer[32];
+    double value = isUpper ? condition.getUpperReal() : condition.getReal();
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    return std::string(buffer, result.ptr);
+  }
+  return std::to_string(isUpper ? condition.getUpperInteger() : condition.getInteger());
+}
+
+void appendPredicate(std::string& dest, const babinov::Condition& condition)
+{
+  appendRaw< uint32_t >(dest, condition.getColumnIndex());
+  appendRaw< uint8_t >(dest, condition.getOperation());
+  appendString(dest, formatBound(condition, false));
+  appendString(dest, formatBound(condition, true));
+}
+
+void appendCondition(std::string& dest, const babinov::Condition& condition)
+{
+  appendRaw< uint8_t >(dest, condition.getLogicalOperation());
+  if (!condition.isCompound())
+  {
+    appendPredicate(dest, condition);
+    return;
+  }
+  const babinov::Vector< babinov::Condition >& operands = condition.getOperands();
+  appendRaw< uint32_t >(dest, operands.size());
+  for (size_t i = 0; i < operands.size(); ++i)
+  {
+    appendCondition(dest, operands[i]);
+  }
+}
+
+bool readPredicate(babinov::SnapshotReader& reader, const babinov::Table& table, babinov::Condition& condition)
+{
+  uint32_t columnIndex = 0;
+  uint8_t operation = 0;
+  std::string value;
+  std::string upperValue;
+  if ((!reader.read(columnIndex)) || (!reader.read(operation)) || (!readString(reader, value))
+    || (!readString(reader, upperValue)) || (columnIndex >= table.getColumns().size()) || (operation > babinov::BETWEEN))
+  {
+    return false;
+  }
+  babinov::DataType dataType = table.getColumns()[columnIndex].second;
+  auto compareOperation = static_cast< babinov::CompareOperation >(operation);
+  condition = babinov::Condition(columnIndex, dataType, compareOperation, value, upperValue);
+  return true;
+}
+
+bool readCondition(babinov::SnapshotReader& reader, const babinov::Table& table, babinov::Condition& condition,
+  size_t depth = 0)
+{
+  uint8_t operation = 0;
+  if ((!reader.read(operation)) || (operation > babinov::LOGICAL_NOT) || (depth > MAX_CONDITION_DEPTH))
+  {
+    return false;
+  }
+  if (operation == babinov::PREDICATE)
+  {
+    return readPredicate(reader, table, condition);
+  }
+  uint32_t nOperands = 0;
+  if (!reader.read(nOperands))
+  {
+    return false;
+  }
+  babinov::Vector< babinov::Condition > operands;
+  babinov::Condition operand;
+  for (size_t i = 0; i < nOperands; ++i)
+  {
+    if (!readCondition(reader, table, operand, depth + 1))
+    {
+      return false;
+    }
+    operands.pushBack(operand);
+  }
+  try
+  {
+    condition = babinov::Condition(static_cast< babinov::LogicalOperation >(operation), operands);
+  }
+  catch (const std::invalid_argument&)
+  {
+    return false;
+  }
+  return true;
+}
+
+void syncDescriptor(std::FILE* file)
+{
+#if defined(__linux__)
+  ::fdatasync(::fileno(file));
+#elif defined(LOG_USE_FSYNC)
+  ::fsync(::fileno(file));
+#else
+  static_cast< void >(file);
+#endif
+}
+
+void truncateDescriptor(std::FILE* file, long size)
+{
+  std::clearerr(file);
+#ifdef LOG_USE_FSYNC
+  static_cast< void >(::ftruncate(::fileno(file), size));
+#else
+  static_cast< void >(size);
+#endif
+}
+
+bool readFingerprint(const std::string& fileName, uint64_t& fingerprint)
+{
+  std::ifstream file(fileName, std::ios::binary);
+  if (!file.is_open())
+  {
+    return false;
+  }
+  std::string block(FINGERPRINT_BLOCK_SIZE, '\0');
+  fingerprint = 0;
+  while (file)
+  {
+    file.read(&block[0], block.size());
+    fingerprint = (fingerprint ^ babinov::checksum(block.data(), file.gcount())) * 0x100000001b3ULL;
+  }
+  return file.eof() && !file.bad();
+}
+
+bool isStale(const char* payload, size_t size, uint64_t fingerprint)
+{
+  uint8_t type = 0;
+  uint64_t lastId = 0;
+  uint64_t recorded = 0;
+  babinov::SnapshotReader reader(payload, size);
+  return reader.read(type) && (type == LOG_CHECKPOINT) && reader.read(lastId) && reader.read(recorded)
+    && (recorded != fingerprint);
+}
+
+bool applyRecord(babinov::SnapshotReader& reader, babinov::Table& table)
+{
+  uint8_t type = 0;
+  if (!reader.read(type))
+  {
+    return false;
+  }
+  if (type == LOG_INSERT)
+  {
+    uint32_t nValues = 0;
+    if (!reader.read(nValues))
+    {
+      return false;
+    }
+    babinov::Table::Row row;
+    std::string value;
+    for (size_t i = 0; i < nValues; ++i)
+    {
+      if (!readString(reader, value))
+      {
+        return false;
+      }
+      row.pushBack(value);
+    }
+    table.insert(row);
+    return true;
+  }
+  else if (type == LOG_UPDATE)
+  {
+    uint64_t rowId = 0;
+    std::string columnName;
+    std::string value;
+    if ((!reader.read(rowId)) || (!readString(reader, columnName)) || (!readString(reader, value)))
+    {
+      return false;
+    }
+    return table.update(rowId, columnName, value);
+  }
+  else if ((type == LOG_DELETE) || (type == LOG_DELETE_WHERE))
+  {
+    babinov::Condition condition;
+    bool isRead = (type == LOG_DELETE) ? readPredicate(reader, table, condition) : readCondition(reader, table, condition);
+    if (!isRead)
+    {
+      return false;
+    }
+    table.del(condition);
+    return true;
+  }
+  else if (type == LOG_UPDATE_WHERE)
+  {
+    babinov::Condition condition;
+    std::string columnName;
+    std::string value;
+    if ((!readCondition(reader, table, condition)) || (!readString(reader, columnName)) || (!readString(reader, value)))
+    {
+      return false;
+    }
+    table.update(condition, columnName, value);
+    return true;
+  }
+  else if (type == LOG_CLEAR)
+  {
+    table.clear();
+    return true;
+  }
+  else if (type == LOG_CHECKPOINT)
+  {
+    uint64_t lastId = 0;
+    uint64_t fingerprint = 0;
+    if ((!reader.read(lastId)) || (!reader.read(fingerprint)))
+    {
+      return false;
+    }
+    table.advanceLastId(lastId);
+    return true;
+  }
+  return false;
+}
+
+namespace babinov
+{
+  WriteAheadLog::WriteAheadLog(const std::string& fileName, bool isTruncated):
+    file_(std::fopen(fileName.c_str(), isTruncated ? "wb" : "ab")),
+    mutex_(),
+    wakeUp_(),
+    policy_(SYNC_GROUP),
+    groupDelayMs_(DEFAULT_GROUP_DELAY_MS),
+    isDirty_(false),
+    isStopped_(false),
+    flusher_()
+  {
+    if (!file_)
+    {
+      throw std::runtime_error("Cannot open log");
+    }
+    std::setvbuf(file_, nullptr, _IONBF, 0);
+    if (!std::ftell(file_))
+    {
+      std::fwrite(LOG_MAGIC, 1, sizeof(LOG_MAGIC), file_);
+      std::fflush(file_);
+      syncDescriptor(file_);
+    }
+    flusher_ = std::thread(&WriteAheadLog::runFlusher, this);
+  }
+
+  WriteAheadLog::~WriteAheadLog()
+  {
+    {
+      std::lock_guard< std::mutex > lock(mutex_);
+      isStopped_ = true;
+    }
+    wakeUp_.notify_one();
+    flusher_.join();
+    std::fflush(file_);
+    syncDescriptor(file_);
+    std::fclose(file_);
+  }
+
+  void WriteAheadLog::setSyncPolicy(SyncPolicy policy, size_t groupDelayMs)
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    policy_ = policy;
+    groupDelayMs_ = groupDelayMs;
+    if (isDirty_ && (policy == SYNC_ALWAYS))
+    {
+      syncDescriptor(file_);
+      isDirty_ = false;
+    }
+  }
+
+  void WriteAheadLog::logInsert(const Table::Row& row)
+  {
+    std::string payload;
+    appendRaw(payload, LOG_INSERT);
+    appendRaw< uint32_t >(payload, row.size());
+    for (size_t i = 0; i < row.size(); ++i)
+    {
+      appendString(payload, row[i]);
+    }
+    append(payload);
+  }
+
+  void WriteAheadLog::logUpdate(size_t rowId, const std::string& columnName, const std::string& value)
+  {
+    std::string payload;
+    appendRaw(payload, LOG_UPDATE);
+    appendRaw< uint64_t >(payload, rowId);
+    appendString(payload, columnName);
+    appendString(payload, value);
+    append(payload);
+  }
+
+  void WriteAheadLog::logUpdate(const Condition& condition, const std::string& columnName, const std::string& value)
+  {
+    std::string payload;
+    appendRaw(payload, LOG_UPDATE_WHERE);
+    appendCondition(payload, condition);
+    appendString(payload, columnName);
+    appendString(payload, value);
+    append(payload);
+  }
+
+  void WriteAheadLog::logDelete(const Condition& condition)
+  {
+    std::string payload;
+    if (condition.isCompound())
+    {
+      appendRaw(payload, LOG_DELETE_WHERE);
+      appendCondition(payload, condition);
+    }
+    else
+    {
+      appendRaw(payload, LOG_DELETE);
+      appendPredicate(payload, condition);
+    }
+    append(payload);
+  }
+
+  void WriteAheadLog::logClear()
+  {
+    std::string payload;
+    appendRaw(payload, LOG_CLEAR);
+    append(payload);
+  }
+
+  void WriteAheadLog::logCheckpoint(size_t lastId, uint64_t fingerprint)
+  {
+    std::string payload;
+    appendRaw(payload, LOG_CHECKPOINT);
+    appendRaw< uint64_t >(payload, lastId);
+    appendRaw< uint64_t >(payload, fingerprint);
+    append(payload);
+  }
+
+  void WriteAheadLog::sync()
+  {
+    std::lock_guard< std::mutex > lock(mutex_);
+    std::fflush(file_);
+    syncDescriptor(file_);
+    isDirty_ = false;
+  }
+
+  void WriteAheadLog::append(const std::string& payload)
+  {
+    std::string record;
+    record.reserve(payload.size() + sizeof(uint32_t) + sizeof(uint64_t));
+    appendRaw< uint32_t >(record, payload.size());
+    appendRaw< uint64_t >(record, checksum(payload.data(), payload.size()));
+    record.append(payload);
+
+    std::unique_lock< std::mutex > lock(mutex_);
+    std::fseek(file_, 0, SEEK_END);
+    long size = std::ftell(file_);
+    if ((std::fwrite(record.data(), 1, record.size(), file_) != record.size()) || std::fflush(file_))
+    {
+      truncateDescriptor(file_, size);
+      throw std::runtime_error("Cannot write log");
+    }
+    if (policy_ == SYNC_ALWAYS)
+    {
+      syncDescriptor(file_);
+    }
+    else if ((policy_ == SYNC_GROUP) && (!isDirty_))
+    {
+      isDirty_ = true;
+      lock.unlock();
+      wakeUp_.notify_one();
+    }
+  }
+
+  void WriteAheadLog::runFlusher()
+  {
+    std::unique_lock< std::mutex > lock(mutex_);
+    while (!isStopped_)
+    {
+      wakeUp_.wait(lock, [this]() { return isDirty_ || isStopped_; });
+      auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(groupDelayMs_);
+      wakeUp_.wait_until(lock, deadline, [this]() { return isStopped_; });
+      if (isDirty_)
+      {
+        isDirty_ = false;
+        std::FILE* file = file_;
+        lock.unlock();
+        syncDescriptor(file);
+        lock.lock();
+      }
+    }
+  }
+
+  std::string getLogFileName(const std::string& tableFileName)
+  {
+    return tableFileName + ".wal";
+  }
+
+  std::unique_ptr< WriteAheadLog > resetLog(const std::string& fileName, size_t lastId, uint64_t fingerprint)
+  {
+    std::string tempName = fileName + ".tmp";
+    std::unique_ptr< WriteAheadLog > log = std::make_unique< WriteAheadLog >(tempName, true);
+    log->logCheckpoint(lastId, fingerprint);
+    log->sync();
+    if (std::rename(tempName.c_str(), fileName.c_str()) || !syncDirectory(fileName))
+    {
+      log.reset();
+      std::remove(tempName.c_str());
+      throw std::runtime_error("Cannot open log");
+    }
+    return log;
+  }
+
+  std::unique_ptr< WriteAheadLog > openLog(const std::string& fileName, size_t lastId, uint64_t fingerprint)
+  {
+    std::error_code error;
+    uintmax_t size = std::filesystem::file_size(fileName, error);
+    if (error || (size <= sizeof(LOG_MAGIC)))
+    {
+      return resetLog(fileName, lastId, fingerprint);
+    }
+    return std::make_unique< WriteAheadLog >(fileName, false);
+  }
+
+  size_t replayLog(const std::string& fileName, Table& table, uint64_t fingerprint)
+  {
+    std::ifstream file(fileName, std::ios::binary);
+    if (!file.is_open())
+    {
+      return 0;
+    }
+    std::string content((std::istreambuf_iterator< char >(file)), std::istreambuf_iterator< char >());
+    file.close();
+    if (content.empty())
+    {
+      return 0;
+    }
+    if ((content.size() < sizeof(LOG_MAGIC)) || std::memcmp(content.data(), LOG_MAGIC, sizeof(LOG_MAGIC)))
+    {
+      throw std::invalid_argument("Invalid log");
+    }
+    SnapshotReader reader(content.data() + sizeof(LOG_MAGIC), content.size() - sizeof(LOG_MAGIC));
+    size_t nRecords = 0;
+    size_t validSize = sizeof(LOG_MAGIC);
+    while (true)
+    {
+      uint32_t size = 0;
+      uint64_t expected = 0;
+      const char* payload = nullptr;
+      if ((!reader.read(size)) || (!reader.read(expected)) || (!reader.readBytes(payload, size))
+        || (checksum(payload, size) != expected))
+      {
+        break;
+      }
+      if (isStale(payload, size, fingerprint) && (validSize == sizeof(LOG_MAGIC)))
+      {
+        std::filesystem::resize_file(fileName, 0);
+        return 0;
+      }
+      SnapshotReader record(payload, size);
+      if (!applyRecord(record, table))
+      {
+        throw std::invalid_argument("Invalid log");
+      }
+      validSize = reader.position() - content.data();
+      nRecords += (static_cast< uint8_t >(payload[0]) != LOG_CHECKPOINT);
+    }
+    if (validSize != content.size())
+    {
+      std::filesystem::resize_file(fileName, validSize);
+    }
+    return nRecords;
+  }
+
+  uint64_t saveTable(const Table& table, const std::string& fileName, bool isBinary)
+  {
+    std::string tempName = fileName + ".tmp";
+    bool isWritten = false;
+    {
+      std::ofstream file(tempName, isBinary ? (std::ios::out | std::ios::binary) : std::ios::out);
+      if (file.is_open())
+      {
+        if (isBinary)
+        {
+          table.writeSnapshot(file);
+        }
+        else
+        {
+          file << table;
+        }
+        file.close();
+        isWritten = !file.fail();
+      }
+    }
+    uint64_t fingerprint = 0;
+    if ((!isWritten) || (!syncFile(tempName)) || (!readFingerprint(tempName, fingerprint))
+      || std::rename(tempName.c_str(), fileName.c_str()))
+    {
+      std::remove(tempName.c_str());
+      throw std::runtime_error("Cannot save table");
+    }
+    if (!syncDirectory(fileName))
+    {
+      throw std::runtime_error("Cannot save table");
+    }
+    return fingerprint;
+  }
+
+  uint64_t getFileFingerprint(const std::string& fileName)
+  {
+    uint64_t fingerprint = 0;
+    if (!readFingerprint(fileName, fingerprint))
+    {
+      throw std::runtime_error("Cannot read file");
+    }
+    return fingerprint;
+  }
+
+  bool syncFile(const std::string& fileName)
+  {
+#ifdef LOG_USE_FSYNC
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    if (fd == -1)
+    {
+      return false;
+    }
+    bool isSynced = !::fsync(fd);
+    return !::close(fd) && isSynced;
+#else
+    static_cast< void >(fileName);
+    return true;
+#endif
+  }
+
+  bool syncDirectory(const std::string& fileName)
+  {
+#ifdef LOG_USE_FSYNC
+    std::filesystem::path directory = std::filesystem::path(fileName).parent_path();
+    return syncFile(directory.empty() ? std::string(".") : directory.string());
+#else
+    static_cast< void >(fileName);
+    return true;
+#endif
+  }
+}
@@ -0,0 +1,69 @@
+#ifndef WRITE_AHEAD_LOG_HPP
+#define WRITE_AHEAD_LOG_HPP
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "condition.hpp"
+#include "hash_policies.hpp"
+#include "tables.hpp"
+
+namespace babinov
+{
+  enum SyncPolicy
+  {
+    SYNC_ALWAYS,
+    SYNC_GROUP,
+    SYNC_OFF
+  };
+
+  class WriteAheadLog
+  {
+  public:
+    static const size_t DEFAULT_GROUP_DELAY_MS = 10;
+
+    WriteAheadLog(const std::string& fileName, bool isTruncated);
+    WriteAheadLog(const WriteAheadLog&) = delete;
+    ~WriteAheadLog();
+    WriteAheadLog& operator=(const WriteAheadLog&) = delete;
+
+    void setSyncPolicy(SyncPolicy policy, size_t groupDelayMs = DEFAULT_GROUP_DELAY_MS);
+    void logInsert(const Table::Row& row);
+    void logUpdate(size_t rowId, const std::string& columnName, const std::string& value);
+    void logUpdate(const Condition& condition, const std::string& columnName, const std::string& value);
+    void logDelete(const Condition& condition);
+    void logClear();
+    void logCheckpoint(size_t lastId, uint64_t fingerprint);
+    void sync();
+
+  private:
+    std::FILE* file_;
+    std::mutex mutex_;
+    std::condition_variable wakeUp_;
+    SyncPolicy policy_;
+    size_t groupDelayMs_;
+    bool isDirty_;
+    bool isStopped_;
+    std::thread flusher_;
+
+    void append(const std::string& payload);
+    void runFlusher();
+  };
+
+  using LogMap = HashMap< std::string, std::unique_ptr< WriteAheadLog > >;
+
+  std::string getLogFileName(const std::string& tableFileName);
+  std::unique_ptr< WriteAheadLog > resetLog(const std::string& fileName, size_t lastId, uint64_t fingerprint);
+  std::unique_ptr< WriteAheadLog > openLog(const std::string& fileName, size_t lastId, uint64_t fingerprint);
+  size_t replayLog(const std::string& fileName, Table& table, uint64_t fingerprint);
+  uint64_t saveTable(const Table& table, const std::string& fileName, bool isBinary);
+  uint64_t getFileFingerprint(const std::string& fileName);
+  bool syncFile(const std::string& fileName);
+  bool syncDirectory(const std::string& fileName);
+}
+
+#endif
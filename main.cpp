@@ -1,24 +1,47 @@
+#include <chrono>
 #include <functional>
 #include <iostream>
 #include <fstream>
 #include <limits>
 #include <stdexcept>
 
-#include "hash_table.hpp"
+#include "hash_policies.hpp"
+#include "prepared_statement.hpp"
+#include "query_profile.hpp"
 #include "tables.hpp"
+#include "write_ahead_log.hpp"
 
 namespace babinov
 {
-  void execCmdTables(const HashTable< std::string, Table >& tables, std::ostream& out);
-  void execCmdLoad(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdSave(const HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdCreate(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdInsert(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdSelect(const HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdUpdate(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdDelete(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdClear(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
-  void execCmdClose(HashTable< std::string, Table >& tables, std::istream& in, std::ostream& out);
+  void execCmdTables(const HashMap< std::string, Table >& tables, std::ostream& out);
+  void execCmdLoad(HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out);
+  void execCmdSave(const HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out);
+  void execCmdCreate(HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out);
+  void execCmdInsert(HashMap< std::string, Table >& tables, LogMap& logs, QueryProfile& profile, std::istream& in,
+    std::ostream& out);
+  void execCmdSelect(const HashMap< std::string, Table >& tables, QueryProfile& profile, std::istream& in,
+    std::ostream& out);
+  void execCmdUpdate(HashMap< std::string, Table >& tables, LogMap& logs, QueryProfile& profile, std::istream& in,
+    std::ostream& out);
+  void execCmdDelete(HashMap< std::string, Table >& tables, LogMap& logs, QueryProfile& profile, std::istream& in,
+    std::ostream& out);
+  void execCmdClear(HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out);
+  void execCmdClose(HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out);
+  void execCmdIndex(HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out);
+  void execCmdWal(const HashMap< std::string, Table >& tables, LogMap& logs, std::istream& in, std::ostream& out);
+  void execCmdThreads(std::istream& in, std::ostream& out);
+  void execCmdCount(const HashMap< std::string, Table >& tables, QueryProfile& profile, std::istream& in,
+    std::ostream& out);
+  void execCmdAggregate(const HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out);
+  void execCmdGroup(const HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out);
+  void execCmdJoin(const HashMap< std::string, Table >& tables, std::istream& in, std::ostream& out);
+  void execCmdSortMemory(std::istream& in, std::ostream& out);
+  void execCmdPrepare(const HashMap< std::string, Table >& tables, StatementMap& statements, std::istream& in,
+    std::ostream& out);
+  void execCmdExec(HashMap< std::string, Table >& tables, LogMap& logs, StatementMap& statements,
+    QueryProfile& profile, std::istream& in, std::ostream& out);
+  void execCmdExplain(const HashMap< std::string, Table >& tables, QueryProfile& profile, std::istream& in);
+  void execCmdProfile(QueryProfile& profile, std::istream& in, std::ostream& out);
 }
 
 #ifdef FILE_TEST_MODE
@@ -30,38 +53,65 @@ std::ifstream file("test_data.txt");
 
 int main()
 {
-  babinov::HashTable< std::string, babinov::Table > tables;
-  babinov::HashTable< std::string, std::function< void(std::istream&, std::ostream&) > > cmds;
+  babinov::HashMap< std::string, babinov::Table > tables;
+  babinov::LogMap logs;
+  babinov::StatementMap statements;
+  babinov::QueryProfile profile;
+  babinov::HashMap< std::string, std::function< void(std::istream&, std::ostream&) > > cmds;
   {
     using namespace std::placeholders;
     cmds["tables"] = std::bind(babinov::execCmdTables, std::cref(tables), _2);
-    cmds["load"] = std::bind(babinov::execCmdLoad, std::ref(tables), _1, _2);
-    cmds["save"] = std::bind(babinov::execCmdSave, std::cref(tables), _1, _2);
+    cmds["load"] = std::bind(babinov::execCmdLoad, std::ref(tables), std::ref(logs), _1, _2);
+    cmds["save"] = std::bind(babinov::execCmdSave, std::cref(tables), std::ref(logs), _1, _2);
     cmds["create"] = std::bind(babinov::execCmdCreate, std::ref(tables), _1, _2);
-    cmds["insert"] = std::bind(babinov::execCmdInsert, std::ref(tables), _1, _2);
-    cmds["select"] = std::bind(babinov::execCmdSelect, std::cref(tables), _1, _2);
-    cmds["update"] = std::bind(babinov::execCmdUpdate, std::ref(tables), _1, _2);
-    cmds["delete"] = std::bind(babinov::execCmdDelete, std::ref(tables), _1, _2);
-    cmds["clear"] = std::bind(babinov::execCmdClear, std::ref(tables), _1, _2);
-    cmds["close"] = std::bind(babinov::execCmdClose, std::ref(tables), _1, _2);
+    cmds["insert"] = std::bind(babinov::execCmdInsert, std::ref(tables), std::ref(logs), std::ref(profile), _1, _2);
+    cmds["select"] = std::bind(babinov::execCmdSelect, std::cref(tables), std::ref(profile), _1, _2);
+    cmds["update"] = std::bind(babinov::execCmdUpdate, std::ref(tables), std::ref(logs), std::ref(profile), _1, _2);
+    cmds["delete"] = std::bind(babinov::execCmdDelete, std::ref(tables), std::ref(logs), std::ref(profile), _1, _2);
+    cmds["clear"] = std::bind(babinov::execCmdClear, std::ref(tables), std::ref(logs), _1, _2);
+    cmds["close"] = std::bind(babinov::execCmdClose, std::ref(tables), std::ref(logs), _1, _2);
+    cmds["index"] = std::bind(babinov::execCmdIndex, std::ref(tables), _1, _2);
+    cmds["wal"] = std::bind(babinov::execCmdWal, std::cref(tables), std::ref(logs), _1, _2);
+    cmds["threads"] = babinov::execCmdThreads;
+    cmds["count"] = std::bind(babinov::execCmdCount, std::cref(tables), std::ref(profile), _1, _2);
+    cmds["aggregate"] = std::bind(babinov::execCmdAggregate, std::cref(tables), _1, _2);
+    cmds["group"] = std::bind(babinov::execCmdGroup, std::cref(tables), _1, _2);
+    cmds["join"] = std::bind(babinov::execCmdJoin, std::cref(tables), _1, _2);
+    cmds["sortmem"] = babinov::execCmdSortMemory;
+    cmds["prepare"] = std::bind(babinov::execCmdPrepare, std::cref(tables), std::ref(statements), _1, _2);
+    cmds["exec"] = std::bind(babinov::execCmdExec, std::ref(tables), std::ref(logs), std::ref(statements),
+      std::ref(profile), _1, _2);
+    cmds["explain"] = std::bind(babinov::execCmdExplain, std::cref(tables), std::ref(profile), _1);
+    cmds["profile"] = std::bind(babinov::execCmdProfile, std::ref(profile), _1, _2);
   }
   std::string cmd;
   std::cout << "==$ ";
 
   while (in >> cmd)
   {
+    profile.reset();
+    babinov::ProfileClock::time_point start = babinov::ProfileClock::now();
+    auto* command = cmds.findValue(cmd);
     try
     {
-      cmds.at(cmd)(in, std::cout);
-    }
-    catch (const std::out_of_range&)
-    {
-      std::cout << "<INVALID COMMAND>" << '\n';
+      if (command)
+      {
+        (*command)(in, std::cout);
+      }
+      else
+      {
+        std::cout << "<INVALID COMMAND>" << '\n';
+      }
     }
     catch (const std::exception& e)
     {
       std::cout << e.what() << '\n';
     }
+    if (profile.isActive())
+    {
+      profile.totalMs = babinov::getElapsedMs(start);
+      babinov::printProfile(std::cout, profile);
+    }
     in.clear();
     in.ignore(std::numeric_limits< std::streamsize >::max(), '\n');
     std::cout << "==$ ";
@@ -0,0 +1,516 @@
+#ifndef B_PLUS_TREE_HPP
+#define B_PLUS_TREE_HPP
+#include <stdexcept>
+#include <utility>
+#include "nodes.hpp"
+#include "vector.hpp"
+#include "b_plus_tree_iterator.hpp"
+#include "b_plus_tree_const_iterator.hpp"
+
+namespace babinov
+{
+  template< class TKey, class TValue >
+  class BPlusTree
+  {
+  public:
+    using ValueType = std::pair< TKey, TValue >;
+    using Node = detail::BPlusTreeNode< TKey, TValue >;
+    using Iterator = BPlusTreeIterator< TKey, TValue >;
+    using ConstIterator = ConstBPlusTreeIterator< TKey, TValue >;
+
+    BPlusTree();
+    BPlusTree(const BPlusTree< TKey, TValue >& other);
+    BPlusTree(BPlusTree< TKey, TValue >&& other) noexcept;
+    ~BPlusTree();
+
+    BPlusTree< TKey, TValue >& operator=(const BPlusTree< TKey, TValue >& other);
+    BPlusTree< TKey, TValue >& operator=(BPlusTree< TKey, TValue >&& other) noexcept;
+    TValue& operator[](const TKey& key);
+    TValue& at(const TKey& key);
+    const TValue& at(const TKey& key) const;
+
+    bool isEmpty() const noexcept;
+    size_t size() const noexcept;
+
+    std::pair< Iterator, bool > insert(const TKey& key, const TValue& value);
+    bool erase(const TKey& key);
+    void swap(BPlusTree< TKey, TValue >& other) noexcept;
+    void clear() noexcept;
+
+    Iterator find(const TKey& key);
+    ConstIterator find(const TKey& key) const;
+    Iterator lowerBound(const TKey& key);
+    ConstIterator lowerBound(const TKey& key) const;
+    Iterator upperBound(const TKey& key);
+    ConstIterator upperBound(const TKey& key) const;
+
+    Iterator begin() noexcept;
+    Iterator end() noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+  private:
+    static const size_t MAX_KEYS_ = 32;
+    Node* root_;
+    size_t count_;
+
+    static void destroy(Node* node) noexcept;
+    static size_t findChildPos(const Node* node, const TKey& key);
+    static size_t findEntryPos(const Node* leaf, const TKey& key);
+    Node* findLeaf(const TKey& key, Vector< Node* >* path, Vector< size_t >* childPos) const;
+    std::pair< Node*, size_t > findLowerBound(const TKey& key) const;
+    void split(Node* node, Vector< Node* >& path, Vector< size_t >& childPos);
+  };
+
+  template< class TKey, class TValue >
+  BPlusTree< TKey, TValue >::BPlusTree():
+    root_(nullptr),
+    count_(0)
+  {}
+
+  template< class TKey, class TValue >
+  BPlusTree< TKey, TValue >::BPlusTree(const BPlusTree< TKey, TValue >& other):
+    BPlusTree()
+  {
+    try
+    {
+      for (auto it = other.cbegin(); it != other.cend(); ++it)
+      {
+        insert((*it).first, (*it).second);
+      }
+    }
+    catch (...)
+    {
+      clear();
+      throw;
+    }
+  }
+
+  template< class TKey, class TValue >
+  BPlusTree< TKey, TValue >::BPlusTree(BPlusTree< TKey, TValue >&& other) noexcept:
+    root_(other.root_),
+    count_(other.count_)
+  {
+    other.root_ = nullptr;
+    other.count_ = 0;
+  }
+
+  template< class TKey, class TValue >
+  BPlusTree< TKey, TValue >::~BPlusTree()
+  {
+    clear();
+  }
+
+  template< class TKey, class TValue >
+  BPlusTree< TKey, TValue >& BPlusTree< TKey, TValue >::operator=(const BPlusTree< TKey, TValue >& other)
+  {
+    if (this != &other)
+    {
+      BPlusTree< TKey, TValue > temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  BPlusTree< TKey, TValue >& BPlusTree< TKey, TValue >::operator=(BPlusTree< TKey, TValue >&& other) noexcept
+  {
+    if (this != &other)
+    {
+      BPlusTree< TKey, TValue > temp(std::move(other));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  TValue& BPlusTree< TKey, TValue >::operator[](const TKey& key)
+  {
+    return (*insert(key, TValue()).first).second;
+  }
+
+  template< class TKey, class TValue >
+  TValue& BPlusTree< TKey, TValue >::at(const TKey& key)
+  {
+    auto desired = find(key);
+    if (desired == end())
+    {
+      throw std::out_of_range("There are not value with specific key");
+    }
+    return (*desired).second;
+  }
+
+  template< class TKey, class TValue >
+  const TValue& BPlusTree< TKey, TValue >::at(const TKey& key) const
+  {
+    auto desired = find(key);
+    if (desired == cend())
+    {
+      throw std::out_of_range("There are not value with specific key");
+    }
+    return (*desired).second;
+  }
+
+  template< class TKey, class TValue >
+  bool BPlusTree< TKey, TValue >::isEmpty() const noexcept
+  {
+    return count_ == 0;
+  }
+
+  template< class TKey, class TValue >
+  size_t BPlusTree< TKey, TValue >::size() const noexcept
+  {
+    return count_;
+  }
+
+  template< class TKey, class TValue >
+  std::pair< BPlusTreeIterator< TKey, TValue >, bool > BPlusTree< TKey, TValue >::insert(
+    const TKey& key, const TValue& value
+  )
+  {
+    if (!root_)
+    {
+      root_ = new Node(true);
+    }
+    Vector< Node* > path;
+    Vector< size_t > childPos;
+    Node* leaf = findLeaf(key, &path, &childPos);
+    size_t pos = findEntryPos(leaf, key);
+    if ((pos < leaf->entries.size()) && !(key < leaf->entries[pos].first))
+    {
+      return std::pair< Iterator, bool >(Iterator(leaf, pos), false);
+    }
+    leaf->entries.insert(pos, ValueType(key, value));
+    ++count_;
+    if (leaf->entries.size() > MAX_KEYS_)
+    {
+      split(leaf, path, childPos);
+      return std::pair< Iterator, bool >(find(key), true);
+    }
+    return std::pair< Iterator, bool >(Iterator(leaf, pos), true);
+  }
+
+  template< class TKey, class TValue >
+  bool BPlusTree< TKey, TValue >::erase(const TKey& key)
+  {
+    if (!root_)
+    {
+      return false;
+    }
+    Vector< Node* > path;
+    Vector< size_t > childPos;
+    Node* node = findLeaf(key, &path, &childPos);
+    size_t pos = findEntryPos(node, key);
+    if ((pos == node->entries.size()) || (key < node->entries[pos].first))
+    {
+      return false;
+    }
+    node->entries.erase(pos);
+    --count_;
+    while ((node != root_) && (node->isLeaf ? node->entries.isEmpty() : node->children.isEmpty()))
+    {
+      if (node->isLeaf)
+      {
+        if (node->prev)
+        {
+          node->prev->next = node->next;
+        }
+        if (node->next)
+        {
+          node->next->prev = node->prev;
+        }
+      }
+      Node* parent = path[path.size() - 1];
+      size_t index = childPos[childPos.size() - 1];
+      path.popBack();
+      childPos.popBack();
+      parent->children.erase(index);
+      if (!parent->keys.isEmpty())
+      {
+        parent->keys.erase(index ? index - 1 : 0);
+      }
+      delete node;
+      node = parent;
+    }
+    while ((!root_->isLeaf) && (root_->children.size() == 1))
+    {
+      Node* oldRoot = root_;
+      root_ = oldRoot->children[0];
+      delete oldRoot;
+    }
+    if (!count_)
+    {
+      clear();
+    }
+    return true;
+  }
+
+  template< class TKey, class TValue >
+  void BPlusTree< TKey, TValue >::swap(BPlusTree< TKey, TValue >& other) noexcept
+  {
+    std::swap(root_, other.root_);
+    std::swap(count_, other.count_);
+  }
+
+  template< class TKey, class TValue >
+  void BPlusTree< TKey, TValue >::clear() noexcept
+  {
+    destroy(root_);
+    root_ = nullptr;
+    count_ = 0;
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::find(const TKey& key)
+  {
+    Iterator desired = lowerBound(key);
+    if ((desired != end()) && !(key < (*desired).first))
+    {
+      return desired;
+    }
+    return end();
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::find(const TKey& key) const
+  {
+    ConstIterator desired = lowerBound(key);
+    if ((desired != cend()) && !(key < (*desired).first))
+    {
+      return desired;
+    }
+    return cend();
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::lowerBound(const TKey& key)
+  {
+    std::pair< Node*, size_t > bound = findLowerBound(key);
+    return Iterator(bound.first, bound.second);
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::lowerBound(const TKey& key) const
+  {
+    std::pair< Node*, size_t > bound = findLowerBound(key);
+    return ConstIterator(bound.first, bound.second);
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::upperBound(const TKey& key)
+  {
+    Iterator bound = lowerBound(key);
+    if ((bound != end()) && !(key < (*bound).first))
+    {
+      ++bound;
+    }
+    return bound;
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::upperBound(const TKey& key) const
+  {
+    ConstIterator bound = lowerBound(key);
+    if ((bound != cend()) && !(key < (*bound).first))
+    {
+      ++bound;
+    }
+    return bound;
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::begin() noexcept
+  {
+    Node* node = root_;
+    while (node && (!node->isLeaf))
+    {
+      node = node->children[0];
+    }
+    return Iterator(node, 0);
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::end() noexcept
+  {
+    return Iterator(nullptr, 0);
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::cbegin() const noexcept
+  {
+    const Node* node = root_;
+    while (node && (!node->isLeaf))
+    {
+      node = node->children[0];
+    }
+    return ConstIterator(node, 0);
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue > BPlusTree< TKey, TValue >::cend() const noexcept
+  {
+    return ConstIterator(nullptr, 0);
+  }
+
+  template< class TKey, class TValue >
+  void BPlusTree< TKey, TValue >::destroy(Node* node) noexcept
+  {
+    if (!node)
+    {
+      return;
+    }
+    for (size_t i = 0; i < node->children.size(); ++i)
+    {
+      destroy(node->children[i]);
+    }
+    delete node;
+  }
+
+  template< class TKey, class TValue >
+  size_t BPlusTree< TKey, TValue >::findChildPos(const Node* node, const TKey& key)
+  {
+    size_t left = 0;
+    size_t right = node->keys.size();
+    while (left < right)
+    {
+      size_t middle = (left + right) / 2;
+      if (key < node->keys[middle])
+      {
+        right = middle;
+      }
+      else
+      {
+        left = middle + 1;
+      }
+    }
+    return left;
+  }
+
+  template< class TKey, class TValue >
+  size_t BPlusTree< TKey, TValue >::findEntryPos(const Node* leaf, const TKey& key)
+  {
+    size_t left = 0;
+    size_t right = leaf->entries.size();
+    while (left < right)
+    {
+      size_t middle = (left + right) / 2;
+      if (leaf->entries[middle].first < key)
+      {
+        left = middle + 1;
+      }
+      else
+      {
+        right = middle;
+      }
+    }
+    return left;
+  }
+
+  template< class TKey, class TValue >
+  detail::BPlusTreeNode< TKey, TValue >* BPlusTree< TKey, TValue >::findLeaf(
+    const TKey& key, Vector< Node* >* path, Vector< size_t >* childPos
+  ) const
+  {
+    Node* node = root_;
+    while (!node->isLeaf)
+    {
+      size_t pos = findChildPos(node, key);
+      if (path)
+      {
+        path->pushBack(node);
+        childPos->pushBack(pos);
+      }
+      node = node->children[pos];
+    }
+    return node;
+  }
+
+  template< class TKey, class TValue >
+  std::pair< detail::BPlusTreeNode< TKey, TValue >*, size_t > BPlusTree< TKey, TValue >::findLowerBound(
+    const TKey& key
+  ) const
+  {
+    if (!root_)
+    {
+      return std::pair< Node*, size_t >(nullptr, 0);
+    }
+    Node* leaf = findLeaf(key, nullptr, nullptr);
+    size_t pos = findEntryPos(leaf, key);
+    if (pos == leaf->entries.size())
+    {
+      return std::pair< Node*, size_t >(leaf->next, 0);
+    }
+    return std::pair< Node*, size_t >(leaf, pos);
+  }
+
+  template< class TKey, class TValue >
+  void BPlusTree< TKey, TValue >::split(Node* node, Vector< Node* >& path, Vector< size_t >& childPos)
+  {
+    while (node->isLeaf ? (node->entries.size() > MAX_KEYS_) : (node->keys.size() > MAX_KEYS_))
+    {
+      Node* sibling = new Node(node->isLeaf);
+      TKey separator;
+      if (node->isLeaf)
+      {
+        size_t middle = node->entries.size() / 2;
+        sibling->entries.reserve(node->entries.size() - middle);
+        for (size_t i = middle; i < node->entries.size(); ++i)
+        {
+          sibling->entries.pushBack(std::move(node->entries[i]));
+        }
+        while (node->entries.size() > middle)
+        {
+          node->entries.popBack();
+        }
+        separator = sibling->entries[0].first;
+        sibling->next = node->next;
+        sibling->prev = node;
+        if (node->next)
+        {
+          node->next->prev = sibling;
+        }
+        node->next = sibling;
+      }
+      else
+      {
+        size_t middle = node->keys.size() / 2;
+        separator = std::move(node->keys[middle]);
+        for (size_t i = middle + 1; i < node->keys.size(); ++i)
+        {
+          sibling->keys.pushBack(std::move(node->keys[i]));
+        }
+        for (size_t i = middle + 1; i < node->children.size(); ++i)
+        {
+          sibling->children.pushBack(node->children[i]);
+        }
+        while (node->keys.size() > middle)
+        {
+          node->keys.popBack();
+        }
+        while (node->children.size() > middle + 1)
+        {
+          node->children.popBack();
+        }
+      }
+
+      if (node == root_)
+      {
+        Node* newRoot = new Node(false);
+        newRoot->keys.pushBack(std::move(separator));
+        newRoot->children.pushBack(node);
+        newRoot->children.pushBack(sibling);
+        root_ = newRoot;
+        return;
+      }
+      Node* parent = path[path.size() - 1];
+      size_t pos = childPos[childPos.size() - 1];
+      path.popBack();
+      childPos.popBack();
+      parent->keys.insert(pos, std::move(separator));
+      parent->children.insert(pos + 1, sibling);
+      node = parent;
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,93 @@
+#ifndef CONST_B_PLUS_TREE_ITERATOR_HPP
+#define CONST_B_PLUS_TREE_ITERATOR_HPP
+#include <iterator>
+#include <utility>
+#include "nodes.hpp"
+#include "b_plus_tree_iterator.hpp"
+
+namespace babinov
+{
+  template< class TKey, class TValue >
+  class BPlusTree;
+
+  template< class TKey, class TValue >
+  class ConstBPlusTreeIterator: public std::iterator< std::forward_iterator_tag, std::pair< TKey, TValue > >
+  {
+    friend class BPlusTree< TKey, TValue >;
+  public:
+    using ValueType = std::pair< TKey, TValue >;
+    using Node = detail::BPlusTreeNode< TKey, TValue >;
+    using ThisType = ConstBPlusTreeIterator< TKey, TValue >;
+
+    ConstBPlusTreeIterator(const Node* leaf, size_t pos):
+      leaf_(leaf),
+      pos_(pos)
+    {}
+
+    explicit ConstBPlusTreeIterator(BPlusTreeIterator< TKey, TValue > iter):
+      leaf_(iter.leaf_),
+      pos_(iter.pos_)
+    {}
+
+    ~ConstBPlusTreeIterator() = default;
+    ConstBPlusTreeIterator(const ThisType&) = default;
+    ThisType& operator=(const ThisType&) = default;
+
+    bool operator==(const ThisType&) const;
+    bool operator!=(const ThisType&) const;
+    const ValueType& operator*() const;
+    const ValueType* operator->() const;
+    ThisType& operator++();
+    ThisType operator++(int);
+
+  private:
+    const Node* leaf_;
+    size_t pos_;
+  };
+
+  template< class TKey, class TValue >
+  bool ConstBPlusTreeIterator< TKey, TValue >::operator==(const ThisType& other) const
+  {
+    return (leaf_ == other.leaf_) && (pos_ == other.pos_);
+  }
+
+  template< class TKey, class TValue >
+  bool ConstBPlusTreeIterator< TKey, TValue >::operator!=(const ThisType& other) const
+  {
+    return !(*this == other);
+  }
+
+  template< class TKey, class TValue >
+  const std::pair< TKey, TValue >& ConstBPlusTreeIterator< TKey, TValue >::operator*() const
+  {
+    return leaf_->entries[pos_];
+  }
+
+  template< class TKey, class TValue >
+  const std::pair< TKey, TValue >* ConstBPlusTreeIterator< TKey, TValue >::operator->() const
+  {
+    return &(**this);
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue >& ConstBPlusTreeIterator< TKey, TValue >::operator++()
+  {
+    ++pos_;
+    if (pos_ == leaf_->entries.size())
+    {
+      leaf_ = leaf_->next;
+      pos_ = 0;
+    }
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  ConstBPlusTreeIterator< TKey, TValue > ConstBPlusTreeIterator< TKey, TValue >::operator++(int)
+  {
+    ThisType temp(*this);
+    operator++();
+    return temp;
+  }
+}
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef B_PLUS_TREE_ITERATOR_HPP
+#define B_PLUS_TREE_ITERATOR_HPP
+#include <iterator>
+#include <utility>
+#include "nodes.hpp"
+
+namespace babinov
+{
+  template< class TKey, class TValue >
+  class BPlusTree;
+
+  template< class TKey, class TValue >
+  class ConstBPlusTreeIterator;
+
+  template< class TKey, class TValue >
+  class BPlusTreeIterator: public std::iterator< std::forward_iterator_tag, std::pair< TKey, TValue > >
+  {
+    friend class BPlusTree< TKey, TValue >;
+    friend class ConstBPlusTreeIterator< TKey, TValue >;
+  public:
+    using ValueType = std::pair< TKey, TValue >;
+    using Node = detail::BPlusTreeNode< TKey, TValue >;
+    using ThisType = BPlusTreeIterator< TKey, TValue >;
+
+    BPlusTreeIterator(Node* leaf, size_t pos):
+      leaf_(leaf),
+      pos_(pos)
+    {}
+
+    ~BPlusTreeIterator() = default;
+    BPlusTreeIterator(const ThisType&) = default;
+    ThisType& operator=(const ThisType&) = default;
+
+    bool operator==(const ThisType&) const;
+    bool operator!=(const ThisType&) const;
+    ValueType& operator*() const;
+    ValueType* operator->() const;
+    ThisType& operator++();
+    ThisType operator++(int);
+
+  private:
+    Node* leaf_;
+    size_t pos_;
+  };
+
+  template< class TKey, class TValue >
+  bool BPlusTreeIterator< TKey, TValue >::operator==(const ThisType& other) const
+  {
+    return (leaf_ == other.leaf_) && (pos_ == other.pos_);
+  }
+
+  template< class TKey, class TValue >
+  bool BPlusTreeIterator< TKey, TValue >::operator!=(const ThisType& other) const
+  {
+    return !(*this == other);
+  }
+
+  template< class TKey, class TValue >
+  std::pair< TKey, TValue >& BPlusTreeIterator< TKey, TValue >::operator*() const
+  {
+    return leaf_->entries[pos_];
+  }
+
+  template< class TKey, class TValue >
+  std::pair< TKey, TValue >* BPlusTreeIterator< TKey, TValue >::operator->() const
+  {
+    return &(**this);
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue >& BPlusTreeIterator< TKey, TValue >::operator++()
+  {
+    ++pos_;
+    if (pos_ == leaf_->entries.size())
+    {
+      leaf_ = leaf_->next;
+      pos_ = 0;
+    }
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  BPlusTreeIterator< TKey, TValue > BPlusTreeIterator< TKey, TValue >::operator++(int)
+  {
+    ThisType temp(*this);
+    operator++();
+    return temp;
+  }
+}
+
+#endif
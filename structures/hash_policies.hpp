@@ -0,0 +1,30 @@
+#ifndef HASH_POLICIES_HPP
+#define HASH_POLICIES_HPP
+#include "hash_table.hpp"
+#include "open_hash_table.hpp"
+
+namespace babinov
+{
+  struct ChainedHashing
+  {
+    template< class TKey, class TValue >
+    using Table = HashTable< TKey, TValue >;
+  };
+
+  struct OpenAddressing
+  {
+    template< class TKey, class TValue >
+    using Table = OpenHashTable< TKey, TValue >;
+  };
+
+#ifdef CHAINED_HASHING_MODE
+  using DefaultHashing = ChainedHashing;
+#else
+  using DefaultHashing = OpenAddressing;
+#endif
+
+  template< class TKey, class TValue, class Policy = DefaultHashing >
+  using HashMap = typename Policy::template Table< TKey, TValue >;
+}
+
+#endif
@@ -4,6 +4,8 @@
 #include <utility>
 #include <initializer_list>
 #include <stdexcept>
+#include <type_traits>
+#include "node_pool.hpp"
 #include "nodes.hpp"
 #include "list.hpp"
 #include "hash_table_iterator.hpp"
@@ -11,24 +13,25 @@
 
 namespace babinov
 {
-  template< class TKey, class TValue >
+  template< class TKey, class TValue, class Allocation = DefaultNodeAllocation >
   class HashTable
   {
   public:
     using ValueType = std::pair< const TKey, TValue >;
     using ListNode = detail::HashTableNode< ValueType >;
-    using ListIterator = typename List< ListNode* >::Iterator;
+    using ListIterator = typename List< ListNode*, Allocation >::Iterator;
+    using NodeAllocator = typename Allocation::template Allocator< ListNode >;
     using Iterator = HashTableIterator< TKey, TValue >;
     using ConstIterator = ConstHashTableIterator< TKey, TValue >;
 
     HashTable();
     HashTable(const std::initializer_list< ValueType >& init);
-    HashTable(const HashTable< TKey, TValue >& other);
-    HashTable(HashTable< TKey, TValue >&& other) noexcept;
+    HashTable(const HashTable< TKey, TValue, Allocation >& other);
+    HashTable(HashTable< TKey, TValue, Allocation >&& other) noexcept;
     ~HashTable();
 
-    HashTable< TKey, TValue >& operator=(const HashTable< TKey, TValue >& other);
-    HashTable< TKey, TValue >& operator=(HashTable< TKey, TValue >&& other) noexcept;
+    HashTable< TKey, TValue, Allocation >& operator=(const HashTable< TKey, TValue, Allocation >& other);
+    HashTable< TKey, TValue, Allocation >& operator=(HashTable< TKey, TValue, Allocation >&& other) noexcept;
     TValue& operator[](const TKey& key);
     TValue& operator[](TKey&& key);
     TValue& at(const TKey& key);
@@ -43,11 +46,15 @@ namespace babinov
     std::pair< Iterator, bool > insert(const TKey& key, TValue&& value);
     Iterator erase(Iterator pos);
     bool erase(const TKey& key);
-    void swap(HashTable< TKey, TValue >& other) noexcept;
+    void swap(HashTable< TKey, TValue, Allocation >& other) noexcept;
     void clear() noexcept;
 
     Iterator find(const TKey& key);
     ConstIterator find(const TKey& key) const;
+    TValue* findValue(const TKey& key);
+    const TValue* findValue(const TKey& key) const;
+    template< class K >
+    const TValue* findEquivalent(const K& key) const;
 
     Iterator begin() noexcept;
     Iterator end() noexcept;
@@ -59,21 +66,25 @@ namespace babinov
     static constexpr float MAX_LOAD_FACTOR_ = 0.75;
     size_t count_;
     size_t capacity_;
-    List< ListNode* > elements_;
+    List< ListNode*, Allocation > elements_;
     ListIterator* buckets_;
+    NodeAllocator nodes_;
 
     size_t calculateNextCapacity(size_t current) const;
     Iterator find(const TKey& key, size_t hash);
-    ConstIterator find(const TKey& key, size_t hash) const;
-    std::pair< Iterator, bool > insert(const TKey& key, const TValue& value, size_t hash);
+    template< class K >
+    ConstIterator find(const K& key, size_t hash) const;
+    template< class V >
+    std::pair< Iterator, bool > insert(const TKey& key, V&& value, size_t hash);
   };
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >::HashTable():
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >::HashTable():
     capacity_(DEFAULT_CAPACITY_),
     count_(0),
     buckets_(new ListIterator[DEFAULT_CAPACITY_]),
-    elements_()
+    elements_(),
+    nodes_()
   {
     for (size_t i = 0; i < DEFAULT_CAPACITY_; ++i)
     {
@@ -81,12 +92,13 @@ namespace babinov
     }
   }
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >::HashTable(const std::initializer_list< ValueType >& init):
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >::HashTable(const std::initializer_list< ValueType >& init):
     capacity_(init.size() / MAX_LOAD_FACTOR_ + 1),
     count_(0),
     buckets_(new ListIterator[init.size() / MAX_LOAD_FACTOR_ + 1]),
-    elements_()
+    elements_(),
+    nodes_()
   {
     for (size_t i = 0; i < capacity_; ++i)
     {
@@ -98,12 +110,13 @@ namespace babinov
     }
   }
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >::HashTable(const HashTable< TKey, TValue >& other):
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >::HashTable(const HashTable< TKey, TValue, Allocation >& other):
     capacity_(other.capacity_),
     count_(0),
     buckets_(new ListIterator[other.capacity_]),
-    elements_()
+    elements_(),
+    nodes_()
   {
     for (size_t i = 0; i < capacity_; ++i)
     {
@@ -120,118 +133,124 @@ namespace babinov
     }
   }
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >::HashTable(HashTable< TKey, TValue >&& other) noexcept:
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >::HashTable(HashTable< TKey, TValue, Allocation >&& other) noexcept:
     capacity_(other.capacity_),
     count_(other.count_),
     elements_(std::move(other.elements_)),
-    buckets_(other.buckets_)
+    buckets_(other.buckets_),
+    nodes_(std::move(other.nodes_))
   {
     other.capacity_ = DEFAULT_CAPACITY_;
     other.count_ = 0;
     other.buckets_ = nullptr;
   }
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >::~HashTable()
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >::~HashTable()
   {
     clear();
     delete[] buckets_;
   }
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >& HashTable< TKey, TValue >::operator=(const HashTable< TKey, TValue >& other)
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >& HashTable< TKey, TValue, Allocation >::operator=(
+    const HashTable< TKey, TValue, Allocation >& other)
   {
     if (this != &other)
     {
-      HashTable< TKey, TValue > temp(other);
+      HashTable< TKey, TValue, Allocation > temp(other);
       swap(temp);
     }
     return *this;
   }
 
-  template< class TKey, class TValue >
-  HashTable< TKey, TValue >& HashTable< TKey, TValue >::operator=(HashTable< TKey, TValue >&& other) noexcept
+  template< class TKey, class TValue, class Allocation >
+  HashTable< TKey, TValue, Allocation >& HashTable< TKey, TValue, Allocation >::operator=(
+    HashTable< TKey, TValue, Allocation >&& other) noexcept
   {
     if (this != &other)
     {
-      HashTable< TKey, TValue > temp(std::move(other));
+      HashTable< TKey, TValue, Allocation > temp(std::move(other));
       swap(temp);
     }
     return *this;
   }
 
-  template< class TKey, class TValue >
-  TValue& HashTable< TKey, TValue >::operator[](const TKey& key)
+  template< class TKey, class TValue, class Allocation >
+  TValue& HashTable< TKey, TValue, Allocation >::operator[](const TKey& key)
   {
     auto desired = insert(key, TValue());
     return (*(desired.first)).second;
   }
 
-  template< class TKey, class TValue >
-  TValue& HashTable< TKey, TValue >::operator[](TKey&& key)
+  template< class TKey, class TValue, class Allocation >
+  TValue& HashTable< TKey, TValue, Allocation >::operator[](TKey&& key)
   {
     return operator[](key);
   }
 
-  template< class TKey, class TValue >
-  TValue& HashTable< TKey, TValue >::at(const TKey& key)
+  template< class TKey, class TValue, class Allocation >
+  TValue& HashTable< TKey, TValue, Allocation >::at(const TKey& key)
   {
-    auto desired = find(key);
-    if (desired == end())
+    TValue* value = findValue(key);
+    if (!value)
     {
       throw std::out_of_range("There are not value with specific key");
     }
-    return (*desired).second;
+    return *value;
   }
 
-  template< class TKey, class TValue >
-  const TValue& HashTable< TKey, TValue >::at(const TKey& key) const
+  template< class TKey, class TValue, class Allocation >
+  const TValue& HashTable< TKey, TValue, Allocation >::at(const TKey& key) const
   {
-    auto desired = find(key);
-    if (desired == cend())
+    const TValue* value = findValue(key);
+    if (!value)
     {
       throw std::out_of_range("There are not value with specific key");
     }
-    return (*desired).second;
+    return *value;
   }
 
-  template< class TKey, class TValue >
-  bool HashTable< TKey, TValue >::isEmpty() const noexcept
+  template< class TKey, class TValue, class Allocation >
+  bool HashTable< TKey, TValue, Allocation >::isEmpty() const noexcept
   {
     return count_ == 0;
   }
 
-  template< class TKey, class TValue >
-  size_t HashTable< TKey, TValue >::size() const noexcept
+  template< class TKey, class TValue, class Allocation >
+  size_t HashTable< TKey, TValue, Allocation >::size() const noexcept
   {
     return count_;
   }
 
-  template< class TKey, class TValue >
-  size_t HashTable< TKey, TValue >::bucketCount() const noexcept
+  template< class TKey, class TValue, class Allocation >
+  size_t HashTable< TKey, TValue, Allocation >::bucketCount() const noexcept
   {
     return capacity_;
   }
 
-  template< class TKey, class TValue >
-  void HashTable< TKey, TValue >::clear() noexcept
+  template< class TKey, class TValue, class Allocation >
+  void HashTable< TKey, TValue, Allocation >::clear() noexcept
   {
-    auto it = elements_.begin();
-    auto temp = it;
-    while (it != elements_.end())
+    if (count_)
     {
-      buckets_[(**it).hash % capacity_] = elements_.end();
-      ++it;
-      delete *temp;
-      elements_.erase(temp);
-      temp = it;
+      for (auto it = elements_.begin(); it != elements_.end(); ++it)
+      {
+        buckets_[(**it).hash % capacity_] = elements_.end();
+        if (!std::is_trivially_destructible< ListNode >::value || !NodeAllocator::RELEASES_NODES)
+        {
+          nodes_.destroy(*it);
+        }
+      }
+      elements_.clear();
     }
+    nodes_.release();
     count_ = 0;
   }
 
-  template< class TKey, class TValue >
-  void HashTable< TKey, TValue >::rehash(size_t count)
+  template< class TKey, class TValue, class Allocation >
+  void HashTable< TKey, TValue, Allocation >::rehash(size_t count)
   {
     size_t newCapacity = DEFAULT_CAPACITY_;
     while ((newCapacity < count) || (newCapacity < (count_ / MAX_LOAD_FACTOR_)))
@@ -244,7 +263,7 @@ namespace babinov
       return;
     }
 
-    List< ListNode* > newElements;
+    List< ListNode*, Allocation > newElements;
     ListIterator* newTable = new ListIterator[newCapacity] {};
     for (size_t i = 0; i < newCapacity; ++i)
     {
@@ -276,31 +295,31 @@ namespace babinov
     capacity_ = newCapacity;
   }
 
-  template< class TKey, class TValue >
-  std::pair< HashTableIterator< TKey, TValue >, bool > HashTable< TKey, TValue >::insert(
+  template< class TKey, class TValue, class Allocation >
+  std::pair< HashTableIterator< TKey, TValue >, bool > HashTable< TKey, TValue, Allocation >::insert(
     const TKey& key, const TValue& value
   )
   {
     return insert(key, value, std::hash< TKey >()(key));
   }
 
-  template< class TKey, class TValue >
-  std::pair< HashTableIterator< TKey, TValue >, bool > HashTable< TKey, TValue >::insert(
+  template< class TKey, class TValue, class Allocation >
+  std::pair< HashTableIterator< TKey, TValue >, bool > HashTable< TKey, TValue, Allocation >::insert(
     const TKey& key, TValue&& value
   )
   {
-    return insert(key, value, std::hash< TKey >()(key));
+    return insert(key, std::move(value), std::hash< TKey >()(key));
   }
 
-  template< class TKey, class TValue >
-  HashTableIterator< TKey, TValue > HashTable< TKey, TValue >::erase(Iterator pos)
+  template< class TKey, class TValue, class Allocation >
+  HashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::erase(Iterator pos)
   {
     ListIterator iter = pos.listIter_;
     size_t hash = (*iter)->hash;
     if ((pos.listIter_ == elements_.begin()) || (((*(--iter))->hash % capacity_) != (hash % capacity_)))
     {
       size_t index = hash % capacity_;
-      delete *(pos.listIter_);
+      nodes_.destroy(*(pos.listIter_));
       ListIterator next = elements_.erase(pos.listIter_);
       if ((next != elements_.end()) && (((*next)->hash % capacity_) == (hash % capacity_)))
       {
@@ -315,14 +334,14 @@ namespace babinov
     }
     else
     {
-      delete *(pos.listIter_);
+      nodes_.destroy(*(pos.listIter_));
       --count_;
       return Iterator(elements_.erase(pos.listIter_));
     }
   }
 
-  template< class TKey, class TValue >
-  bool HashTable< TKey, TValue >::erase(const TKey& key)
+  template< class TKey, class TValue, class Allocation >
+  bool HashTable< TKey, TValue, Allocation >::erase(const TKey& key)
   {
     auto it = find(key);
     if (it != end())
@@ -333,53 +352,76 @@ namespace babinov
     return false;
   }
 
-  template< class TKey, class TValue >
-  void HashTable< TKey, TValue >::swap(HashTable< TKey, TValue >& other) noexcept
+  template< class TKey, class TValue, class Allocation >
+  void HashTable< TKey, TValue, Allocation >::swap(HashTable< TKey, TValue, Allocation >& other) noexcept
   {
     std::swap(capacity_, other.capacity_);
     std::swap(count_, other.count_);
     std::swap(elements_, other.elements_);
     std::swap(buckets_, other.buckets_);
+    nodes_.swap(other.nodes_);
   }
 
-  template< class TKey, class TValue >
-  HashTableIterator< TKey, TValue > HashTable< TKey, TValue >::find(const TKey& key)
+  template< class TKey, class TValue, class Allocation >
+  HashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::find(const TKey& key)
   {
     return find(key, std::hash< TKey >()(key));
   }
 
-  template< class TKey, class TValue >
-  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue >::find(const TKey& key) const
+  template< class TKey, class TValue, class Allocation >
+  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::find(const TKey& key) const
   {
     return find(key, std::hash< TKey >()(key));
   }
 
-  template< class TKey, class TValue >
-  HashTableIterator< TKey, TValue > HashTable< TKey, TValue >::begin() noexcept
+  template< class TKey, class TValue, class Allocation >
+  TValue* HashTable< TKey, TValue, Allocation >::findValue(const TKey& key)
+  {
+    auto desired = find(key);
+    return (desired == end()) ? nullptr : &(*desired).second;
+  }
+
+  template< class TKey, class TValue, class Allocation >
+  const TValue* HashTable< TKey, TValue, Allocation >::findValue(const TKey& key) const
+  {
+    auto desired = find(key);
+    return (desired == cend()) ? nullptr : &(*desired).second;
+  }
+
+  template< class TKey, class TValue, class Allocation >
+  template< class K >
+  const TValue* HashTable< TKey, TValue, Allocation >::findEquivalent(const K& key) const
+  {
+    auto desired = find(key, std::hash< K >()(key));
+    return (desired == cend()) ? nullptr : &(*desired).second;
+  }
+
+  template< class TKey, class TValue, class Allocation >
+  HashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::begin() noexcept
   {
     return Iterator(elements_.begin());
   }
 
-  template< class TKey, class TValue >
-  HashTableIterator< TKey, TValue > HashTable< TKey, TValue >::end() noexcept
+  template< class TKey, class TValue, class Allocation >
+  HashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::end() noexcept
   {
     return Iterator(elements_.end());
   }
 
-  template< class TKey, class TValue >
-  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue >::cbegin() const noexcept
+  template< class TKey, class TValue, class Allocation >
+  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::cbegin() const noexcept
   {
     return ConstIterator(elements_.cbegin());
   }
 
-  template< class TKey, class TValue >
-  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue >::cend() const noexcept
+  template< class TKey, class TValue, class Allocation >
+  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::cend() const noexcept
   {
     return ConstIterator(elements_.cend());
   }
 
-  template< class TKey, class TValue >
-  size_t HashTable< TKey, TValue >::calculateNextCapacity(size_t current) const
+  template< class TKey, class TValue, class Allocation >
+  size_t HashTable< TKey, TValue, Allocation >::calculateNextCapacity(size_t current) const
   {
     size_t degree = 0;
     for (; current > std::pow(2, degree); ++degree) {};
@@ -387,8 +429,8 @@ namespace babinov
     return std::pow(2, degree) - (std::pow(2, degree) - std::pow(2, degree - 1)) / 2 - 1;
   }
 
-  template< class TKey, class TValue >
-  HashTableIterator< TKey, TValue > HashTable< TKey, TValue >::find(const TKey& key, size_t hash)
+  template< class TKey, class TValue, class Allocation >
+  HashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::find(const TKey& key, size_t hash)
   {
     size_t index = hash % capacity_;
     auto bucketIter = buckets_[index];
@@ -409,8 +451,10 @@ namespace babinov
     return end();
   }
 
-  template< class TKey, class TValue >
-  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue >::find(const TKey& key, size_t hash) const
+  template< class TKey, class TValue, class Allocation >
+  template< class K >
+  ConstHashTableIterator< TKey, TValue > HashTable< TKey, TValue, Allocation >::find(
+    const K& key, size_t hash) const
   {
     size_t index = hash % capacity_;
     auto bucketIter = buckets_[index];
@@ -431,9 +475,10 @@ namespace babinov
     return cend();
   }
 
-  template< class TKey, class TValue >
-  std::pair< HashTableIterator< TKey, TValue >, bool > HashTable< TKey, TValue >::insert(
-    const TKey& key, const TValue& value, size_t hash)
+  template< class TKey, class TValue, class Allocation >
+  template< class V >
+  std::pair< HashTableIterator< TKey, TValue >, bool > HashTable< TKey, TValue, Allocation >::insert(
+    const TKey& key, V&& value, size_t hash)
   {
     Iterator desired = find(key, hash);
     if (desired != end())
@@ -448,7 +493,7 @@ namespace babinov
       index = hash % capacity_;
     }
 
-    ListNode* node = new ListNode(ValueType(key, value), hash);
+    ListNode* node = nodes_.create(ValueType(key, std::forward< V >(value)), hash);
     std::pair < Iterator, bool > result(end(), true);
     try
     {
@@ -467,7 +512,7 @@ namespace babinov
     }
     catch (...)
     {
-      delete node;
+      nodes_.destroy(node);
       throw;
     }
     ++count_;
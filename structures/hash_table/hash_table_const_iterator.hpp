@@ -8,13 +8,14 @@
 
 namespace babinov
 {
-  template< class TKey, class TValue >
+  template< class TKey, class TValue, class Allocation >
   class HashTable;
 
   template< class TKey, class TValue >
   class ConstHashTableIterator : public std::iterator< std::forward_iterator_tag, std::pair< const TKey, TValue > >
   {
-    friend class HashTable< TKey, TValue >;
+    template< class K, class V, class Allocation >
+    friend class HashTable;
   public:
     using ValueType = std::pair< const TKey, TValue >;
     using ListNode = detail::HashTableNode< ValueType >;
@@ -6,13 +6,14 @@
 
 namespace babinov
 {
-  template< class T >
+  template< class T, class Allocation >
   class List;
 
   template< class T >
   class ConstListIterator: public std::iterator< std::bidirectional_iterator_tag, T >
   {
-    friend class List< T >;
+    template< class U, class Allocation >
+    friend class List;
   public:
     using BaseNode = detail::BaseListNode;
     using ThisType = ConstListIterator< T >;
@@ -55,7 +56,7 @@ namespace babinov
   const T& ConstListIterator< T >::operator*() const
   {
     assert(current_ != nullptr);
-    return (*dynamic_cast< const detail::ListNode< T >* >(current_)).data;
+    return static_cast< const detail::ListNode< T >* >(current_)->data;
   }
 
   template< class T >
@@ -1,18 +1,21 @@
 #ifndef LIST_HPP
 #define LIST_HPP
+#include <type_traits>
 #include <utility>
 #include "list_iterator.hpp"
 #include "const_list_iterator.hpp"
+#include "node_pool.hpp"
 #include "nodes.hpp"
 
 namespace babinov
 {
-  template< class T >
+  template< class T, class Allocation = DefaultNodeAllocation >
   class List
   {
   public:
     using BaseNode = detail::BaseListNode;
     using Node = detail::ListNode< T >;
+    using NodeAllocator = typename Allocation::template Allocator< Node >;
     using Iterator = ListIterator< T >;
     using ConstIterator = ConstListIterator< T >;
 
@@ -49,17 +52,20 @@ namespace babinov
   private:
     BaseNode* fake_;
     size_t size_;
+    NodeAllocator nodes_;
   };
 
-  template< class T >
-  List< T >::List():
+  template< class T, class Allocation >
+  List< T, Allocation >::List():
     size_(0),
-    fake_(new BaseNode())
+    fake_(new BaseNode()),
+    nodes_()
   {}
 
-  template< class T >
-  List< T >::List(const List< T >& other):
-    size_(0)
+  template< class T, class Allocation >
+  List< T, Allocation >::List(const List< T, Allocation >& other):
+    size_(0),
+    nodes_()
   {
     fake_ = new BaseNode();
     for (auto it = other.cbegin(); it != other.cend(); ++it)
@@ -68,96 +74,97 @@ namespace babinov
     }
   }
 
-  template< class T >
-  List< T >::List(List< T >&& other) noexcept:
+  template< class T, class Allocation >
+  List< T, Allocation >::List(List< T, Allocation >&& other) noexcept:
     size_(other.size_),
-    fake_(other.fake_)
+    fake_(other.fake_),
+    nodes_(std::move(other.nodes_))
   {
     other.size_ = 0;
     other.fake_ = nullptr;
   }
 
-  template< class T >
-  List< T >::~List()
+  template< class T, class Allocation >
+  List< T, Allocation >::~List()
   {
     clear();
     delete fake_;
   }
 
-  template< class T >
-  List< T >& List< T >::operator=(const List& other)
+  template< class T, class Allocation >
+  List< T, Allocation >& List< T, Allocation >::operator=(const List& other)
   {
     if (this != &other)
     {
-      List< T > temp(other);
+      List< T, Allocation > temp(other);
       swap(temp);
     }
     return *this;
   }
 
-  template< class T >
-  List< T >& List< T >::operator=(List&& other) noexcept
+  template< class T, class Allocation >
+  List< T, Allocation >& List< T, Allocation >::operator=(List&& other) noexcept
   {
     if (this != &other)
     {
-      List< T > temp(std::move(other));
+      List< T, Allocation > temp(std::move(other));
       swap(temp);
     }
     return *this;
   }
 
-  template< class T >
-  bool List< T >::isEmpty() const noexcept
+  template< class T, class Allocation >
+  bool List< T, Allocation >::isEmpty() const noexcept
   {
     return size_ == 0;
   }
 
-  template< class T >
-  size_t List< T >::size() const noexcept
+  template< class T, class Allocation >
+  size_t List< T, Allocation >::size() const noexcept
   {
     return size_;
   }
 
-  template< class T >
-  T& List< T >::front()
+  template< class T, class Allocation >
+  T& List< T, Allocation >::front()
   {
     return *begin();
   }
 
-  template< class T >
-  T& List< T >::back()
+  template< class T, class Allocation >
+  T& List< T, Allocation >::back()
   {
     return *std::prev(end());
   }
 
-  template< class T >
-  void List< T >::pushFront(const T& value)
+  template< class T, class Allocation >
+  void List< T, Allocation >::pushFront(const T& value)
   {
     insert(begin(), value);
   }
 
-  template< class T >
-  void List< T >::pushBack(const T& value)
+  template< class T, class Allocation >
+  void List< T, Allocation >::pushBack(const T& value)
   {
     insert(end(), value);
   }
 
-  template< class T >
-  void List< T >::popFront()
+  template< class T, class Allocation >
+  void List< T, Allocation >::popFront()
   {
     erase(begin());
   }
 
-  template< class T >
-  void List< T >::popBack()
+  template< class T, class Allocation >
+  void List< T, Allocation >::popBack()
   {
     erase(std::prev(end()));
   }
 
-  template< class T >
-  ListIterator< T > List< T >::insert(Iterator pos, const T& value)
+  template< class T, class Allocation >
+  ListIterator< T > List< T, Allocation >::insert(Iterator pos, const T& value)
   {
-    Node* newNode = new Node(value);
+    Node* newNode = nodes_.create(value);
     BaseNode* currentNode = pos.current_;
     newNode->next = currentNode;
     if (size_)
@@ -175,44 +182,45 @@ namespace babinov
     return Iterator(newNode);
   }
 
-  template< class T >
-  ListIterator< T > List< T >::erase(Iterator pos)
+  template< class T, class Allocation >
+  ListIterator< T > List< T, Allocation >::erase(Iterator pos)
   {
     assert(size_ != 0);
     BaseNode* node = pos.current_;
     node->prev->next = node->next;
     node->next->prev = node->prev;
     ++pos;
-    delete node;
+    nodes_.destroy(static_cast< Node* >(node));
     --size_;
     return pos;
   }
 
-  template< class T >
-  void List< T >::clear() noexcept
+  template< class T, class Allocation >
+  void List< T, Allocation >::clear() noexcept
   {
-    if (!size_)
-    {
-      return;
-    }
-    BaseNode* current = fake_->next;
-    while (current != fake_)
+    if (size_ && (!std::is_trivially_destructible< T >::value || !NodeAllocator::RELEASES_NODES))
     {
-      current = current->next;
-      delete current->prev;
+      BaseNode* current = fake_->next;
+      while (current != fake_)
+      {
+        current = current->next;
+        nodes_.destroy(static_cast< Node* >(current->prev));
+      }
     }
+    nodes_.release();
     size_ = 0;
   }
 
-  template< class T >
-  void List< T >::swap(List& other) noexcept
+  template< class T, class Allocation >
+  void List< T, Allocation >::swap(List& other) noexcept
   {
     std::swap(size_, other.size_);
     std::swap(fake_, other.fake_);
+    nodes_.swap(other.nodes_);
   }
 
-  template< class T >
-  ListIterator< T > List< T >::begin() noexcept
+  template< class T, class Allocation >
+  ListIterator< T > List< T, Allocation >::begin() noexcept
   {
     if (!size_)
     {
@@ -221,8 +229,8 @@ namespace babinov
     return Iterator(fake_->next);
   }
 
-  template< class T >
-  ListIterator< T > List< T >::begin() const noexcept
+  template< class T, class Allocation >
+  ListIterator< T > List< T, Allocation >::begin() const noexcept
   {
     if (!size_)
     {
@@ -231,8 +239,8 @@ namespace babinov
     return Iterator(fake_->next);
   }
 
-  template< class T >
-  ConstListIterator< T > List< T >::cbegin() const noexcept
+  template< class T, class Allocation >
+  ConstListIterator< T > List< T, Allocation >::cbegin() const noexcept
   {
     if (!size_)
     {
@@ -241,20 +249,20 @@ namespace babinov
     return ConstIterator(fake_->next);
   }
 
-  template< class T >
-  ListIterator< T > List< T >::end() noexcept
+  template< class T, class Allocation >
+  ListIterator< T > List< T, Allocation >::end() noexcept
   {
     return Iterator(fake_);
   }
 
-  template< class T >
-  ListIterator< T > List< T >::end() const noexcept
+  template< class T, class Allocation >
+  ListIterator< T > List< T, Allocation >::end() const noexcept
   {
     return Iterator(fake_);
   }
 
-  template< class T >
-  ConstListIterator< T > List< T >::cend() const noexcept
+  template< class T, class Allocation >
+  ConstListIterator< T > List< T, Allocation >::cend() const noexcept
   {
     return ConstIterator(fake_);
   }
@@ -6,7 +6,7 @@
 
 namespace babinov
 {
-  template< class T >
+  template< class T, class Allocation >
   class List;
 
   template< class T >
@@ -15,7 +15,8 @@ namespace babinov
   template< class T >
   class ListIterator: public std::iterator< std::bidirectional_iterator_tag, T >
   {
-    friend class List< T >;
+    template< class U, class Allocation >
+    friend class List;
     friend class ConstListIterator< T >;
   public:
     using BaseNode = detail::BaseListNode;
@@ -61,14 +62,14 @@ namespace babinov
   T& ListIterator< T >::operator*()
   {
     assert(current_ != nullptr);
-    return (*dynamic_cast< detail::ListNode< T >* >(current_)).data;
+    return static_cast< detail::ListNode< T >* >(current_)->data;
   }
 
   template< class T >
   const T& ListIterator< T >::operator*() const
   {
     assert(current_ != nullptr);
-    return (*dynamic_cast< detail::ListNode< T >* >(current_)).data;
+    return static_cast< detail::ListNode< T >* >(current_)->data;
   }
 
   template< class T >
@@ -0,0 +1,199 @@
+#ifndef NODE_POOL_HPP
+#define NODE_POOL_HPP
+#include <new>
+#include <utility>
+
+namespace babinov
+{
+  template< class Node >
+  class NodePool
+  {
+  public:
+    static const bool RELEASES_NODES = true;
+
+    NodePool() noexcept;
+    NodePool(const NodePool&) = delete;
+    NodePool(NodePool&& other) noexcept;
+    ~NodePool();
+
+    NodePool& operator=(const NodePool&) = delete;
+    NodePool& operator=(NodePool&& other) noexcept;
+
+    template< class... Args >
+    Node* create(Args&&... args);
+    void destroy(Node* node) noexcept;
+    void release() noexcept;
+    void swap(NodePool& other) noexcept;
+
+  private:
+    union Cell
+    {
+      Cell* next;
+      alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    static const size_t MIN_SLAB_SIZE_ = 8;
+    static const size_t MAX_SLAB_SIZE_ = 1024;
+    Cell* slabs_;
+    Cell* free_;
+    Cell* next_;
+    Cell* end_;
+    size_t slabSize_;
+
+    void grow();
+  };
+
+  template< class Node >
+  class HeapNodePool
+  {
+  public:
+    static const bool RELEASES_NODES = false;
+
+    template< class... Args >
+    Node* create(Args&&... args)
+    {
+      return new Node(std::forward< Args >(args)...);
+    }
+
+    void destroy(Node* node) noexcept
+    {
+      delete node;
+    }
+
+    void release() noexcept
+    {}
+
+    void swap(HeapNodePool&) noexcept
+    {}
+  };
+
+  struct PooledNodes
+  {
+    template< class Node >
+    using Allocator = NodePool< Node >;
+  };
+
+  struct HeapNodes
+  {
+    template< class Node >
+    using Allocator = HeapNodePool< Node >;
+  };
+
+#ifdef HEAP_NODES_MODE
+  using DefaultNodeAllocation = HeapNodes;
+#else
+  using DefaultNodeAllocation = PooledNodes;
+#endif
+
+  template< class Node >
+  NodePool< Node >::NodePool() noexcept:
+    slabs_(nullptr),
+    free_(nullptr),
+    next_(nullptr),
+    end_(nullptr),
+    slabSize_(MIN_SLAB_SIZE_)
+  {}
+
+  template< class Node >
+  NodePool< Node >::NodePool(NodePool&& other) noexcept:
+    NodePool()
+  {
+    swap(other);
+  }
+
+  template< class Node >
+  NodePool< Node >::~NodePool()
+  {
+    release();
+  }
+
+  template< class Node >
+  NodePool< Node >& NodePool< Node >::operator=(NodePool&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      swap(other);
+    }
+    return *this;
+  }
+
+  template< class Node >
+  template< class... Args >
+  Node* NodePool< Node >::create(Args&&... args)
+  {
+    Cell* cell = free_;
+    if (cell)
+    {
+      free_ = cell->next;
+    }
+    else
+    {
+      if (next_ == end_)
+      {
+        grow();
+      }
+      cell = next_++;
+    }
+    try
+    {
+      return new (cell->storage) Node(std::forward< Args >(args)...);
+    }
+    catch (...)
+    {
+      cell->next = free_;
+      free_ = cell;
+      throw;
+    }
+  }
+
+  template< class Node >
+  void NodePool< Node >::destroy(Node* node) noexcept
+  {
+    node->~Node();
+    Cell* cell = reinterpret_cast< Cell* >(node);
+    cell->next = free_;
+    free_ = cell;
+  }
+
+  template< class Node >
+  void NodePool< Node >::release() noexcept
+  {
+    while (slabs_)
+    {
+      Cell* next = slabs_->next;
+      delete[] slabs_;
+      slabs_ = next;
+    }
+    free_ = nullptr;
+    next_ = nullptr;
+    end_ = nullptr;
+    slabSize_ = MIN_SLAB_SIZE_;
+  }
+
+  template< class Node >
+  void NodePool< Node >::swap(NodePool& other) noexcept
+  {
+    std::swap(slabs_, other.slabs_);
+    std::swap(free_, other.free_);
+    std::swap(next_, other.next_);
+    std::swap(end_, other.end_);
+    std::swap(slabSize_, other.slabSize_);
+  }
+
+  template< class Node >
+  void NodePool< Node >::grow()
+  {
+    Cell* slab = new Cell[slabSize_];
+    slab->next = slabs_;
+    slabs_ = slab;
+    next_ = slab + 1;
+    end_ = slab + slabSize_;
+    if (slabSize_ < MAX_SLAB_SIZE_)
+    {
+      slabSize_ *= 2;
+    }
+  }
+}
+
+#endif
@@ -1,5 +1,7 @@
 #ifndef NODES_HPP
 #define NODES_HPP
+#include <utility>
+#include "vector.hpp"
 
 namespace babinov
 {
@@ -13,14 +15,13 @@ namespace babinov
         next(nullptr),
         prev(nullptr)
       {}
-      virtual ~BaseListNode() = default;
     };
 
     template< class T >
     struct ListNode: BaseListNode
     {
       T data;
-      ListNode(const T& newData):
+      explicit ListNode(const T& newData):
         BaseListNode(),
         data(newData)
       {}
@@ -35,6 +36,29 @@ namespace babinov
         data(newData),
         hash(h)
       {}
+      HashTableNode(T&& newData, size_t h):
+        data(std::move(newData)),
+        hash(h)
+      {}
+    };
+
+    template< class TKey, class TValue >
+    struct BPlusTreeNode
+    {
+      bool isLeaf;
+      Vector< std::pair< TKey, TValue > > entries;
+      Vector< TKey > keys;
+      Vector< BPlusTreeNode* > children;
+      BPlusTreeNode* next;
+      BPlusTreeNode* prev;
+      explicit BPlusTreeNode(bool leaf):
+        isLeaf(leaf),
+        entries(),
+        keys(),
+        children(),
+        next(nullptr),
+        prev(nullptr)
+      {}
     };
   }
 }
@@ -0,0 +1,94 @@
+#ifndef CONTROL_GROUP_HPP
+#define CONTROL_GROUP_HPP
+#include <cstddef>
+#include <cstdint>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace babinov
+{
+  namespace detail
+  {
+    const signed char CTRL_EMPTY = -128;
+    const signed char CTRL_DELETED = -2;
+    const size_t GROUP_WIDTH = 16;
+
+    inline bool isFull(signed char ctrl) noexcept
+    {
+      return ctrl >= 0;
+    }
+
+    inline size_t mixHash(size_t hash) noexcept
+    {
+      std::uint64_t h = hash;
+      h ^= h >> 33;
+      h *= 0xff51afd7ed558ccdULL;
+      h ^= h >> 33;
+      return static_cast< size_t >(h);
+    }
+
+    inline size_t countTrailingZeros(std::uint32_t mask) noexcept
+    {
+      return __builtin_ctz(mask);
+    }
+
+    class ControlGroup
+    {
+    public:
+      explicit ControlGroup(const signed char* ctrl) noexcept
+      {
+#ifdef __SSE2__
+        ctrl_ = _mm_loadu_si128(reinterpret_cast< const __m128i* >(ctrl));
+#else
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+          ctrl_[i] = ctrl[i];
+        }
+#endif
+      }
+
+      std::uint32_t match(signed char h2) const noexcept
+      {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_));
+#else
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+          mask |= static_cast< std::uint32_t >(ctrl_[i] == h2) << i;
+        }
+        return mask;
+#endif
+      }
+
+      std::uint32_t matchEmpty() const noexcept
+      {
+        return match(CTRL_EMPTY);
+      }
+
+      std::uint32_t matchFree() const noexcept
+      {
+#ifdef __SSE2__
+        return _mm_movemask_epi8(_mm_cmpgt_epi8(_mm_setzero_si128(), ctrl_));
+#else
+        std::uint32_t mask = 0;
+        for (size_t i = 0; i < GROUP_WIDTH; ++i)
+        {
+          mask |= static_cast< std::uint32_t >(ctrl_[i] < 0) << i;
+        }
+        return mask;
+#endif
+      }
+
+    private:
+#ifdef __SSE2__
+      __m128i ctrl_;
+#else
+      signed char ctrl_[GROUP_WIDTH];
+#endif
+    };
+  }
+}
+
+#endif
@@ -0,0 +1,505 @@
+#ifndef OPEN_HASH_TABLE_HPP
+#define OPEN_HASH_TABLE_HPP
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <utility>
+#include "control_group.hpp"
+#include "open_hash_table_iterator.hpp"
+#include "open_hash_table_const_iterator.hpp"
+
+namespace babinov
+{
+  template< class TKey, class TValue >
+  class OpenHashTable
+  {
+  public:
+    using ValueType = std::pair< const TKey, TValue >;
+    using Iterator = OpenHashTableIterator< TKey, TValue >;
+    using ConstIterator = ConstOpenHashTableIterator< TKey, TValue >;
+
+    OpenHashTable();
+    OpenHashTable(const std::initializer_list< ValueType >& init);
+    OpenHashTable(const OpenHashTable< TKey, TValue >& other);
+    OpenHashTable(OpenHashTable< TKey, TValue >&& other) noexcept;
+    ~OpenHashTable();
+
+    OpenHashTable< TKey, TValue >& operator=(const OpenHashTable< TKey, TValue >& other);
+    OpenHashTable< TKey, TValue >& operator=(OpenHashTable< TKey, TValue >&& other) noexcept;
+    TValue& operator[](const TKey& key);
+    TValue& operator[](TKey&& key);
+    TValue& at(const TKey& key);
+    const TValue& at(const TKey& key) const;
+
+    bool isEmpty() const noexcept;
+    size_t size() const noexcept;
+    size_t bucketCount() const noexcept;
+
+    void rehash(size_t count);
+    std::pair< Iterator, bool > insert(const TKey& key, const TValue& value);
+    std::pair< Iterator, bool > insert(const TKey& key, TValue&& value);
+    Iterator erase(Iterator pos);
+    bool erase(const TKey& key);
+    void swap(OpenHashTable< TKey, TValue >& other) noexcept;
+    void clear() noexcept;
+
+    Iterator find(const TKey& key);
+    ConstIterator find(const TKey& key) const;
+    TValue* findValue(const TKey& key);
+    const TValue* findValue(const TKey& key) const;
+    template< class K >
+    const TValue* findEquivalent(const K& key) const;
+
+    Iterator begin() noexcept;
+    Iterator end() noexcept;
+    ConstIterator cbegin() const noexcept;
+    ConstIterator cend() const noexcept;
+
+  private:
+    static const size_t MIN_CAPACITY_ = detail::GROUP_WIDTH;
+    signed char* ctrl_;
+    ValueType* slots_;
+    size_t count_;
+    size_t nDeleted_;
+    size_t capacity_;
+
+    template< class K >
+    static size_t calculateHash(const K& key);
+    size_t maxLoad() const noexcept;
+    template< class K >
+    size_t findIndex(const K& key, size_t hash) const;
+    size_t findFreeIndex(size_t hash) const;
+    template< class V >
+    std::pair< Iterator, bool > emplace(const TKey& key, V&& value);
+  };
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >::OpenHashTable():
+    ctrl_(nullptr),
+    slots_(nullptr),
+    count_(0),
+    nDeleted_(0),
+    capacity_(0)
+  {}
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >::OpenHashTable(const std::initializer_list< ValueType >& init):
+    OpenHashTable()
+  {
+    rehash(init.size());
+    for (auto it = init.begin(); it != init.end(); ++it)
+    {
+      insert((*it).first, (*it).second);
+    }
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >::OpenHashTable(const OpenHashTable< TKey, TValue >& other):
+    ctrl_(nullptr),
+    slots_(nullptr),
+    count_(0),
+    nDeleted_(other.nDeleted_),
+    capacity_(other.capacity_)
+  {
+    if (!capacity_)
+    {
+      return;
+    }
+    ctrl_ = new signed char[capacity_];
+    std::memset(ctrl_, detail::CTRL_EMPTY, capacity_);
+    slots_ = static_cast< ValueType* >(::operator new(capacity_ * sizeof(ValueType)));
+    try
+    {
+      for (size_t i = 0; i < capacity_; ++i)
+      {
+        if (detail::isFull(other.ctrl_[i]))
+        {
+          new (slots_ + i) ValueType(other.slots_[i]);
+          ctrl_[i] = other.ctrl_[i];
+          ++count_;
+        }
+      }
+    }
+    catch (...)
+    {
+      clear();
+      delete[] ctrl_;
+      ::operator delete(slots_);
+      throw;
+    }
+    std::memcpy(ctrl_, other.ctrl_, capacity_);
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >::OpenHashTable(OpenHashTable< TKey, TValue >&& other) noexcept:
+    ctrl_(other.ctrl_),
+    slots_(other.slots_),
+    count_(other.count_),
+    nDeleted_(other.nDeleted_),
+    capacity_(other.capacity_)
+  {
+    other.ctrl_ = nullptr;
+    other.slots_ = nullptr;
+    other.count_ = 0;
+    other.nDeleted_ = 0;
+    other.capacity_ = 0;
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >::~OpenHashTable()
+  {
+    clear();
+    delete[] ctrl_;
+    ::operator delete(slots_);
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >& OpenHashTable< TKey, TValue >::operator=(const OpenHashTable< TKey, TValue >& other)
+  {
+    if (this != &other)
+    {
+      OpenHashTable< TKey, TValue > temp(other);
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTable< TKey, TValue >& OpenHashTable< TKey, TValue >::operator=(OpenHashTable< TKey, TValue >&& other) noexcept
+  {
+    if (this != &other)
+    {
+      OpenHashTable< TKey, TValue > temp(std::move(other));
+      swap(temp);
+    }
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  TValue& OpenHashTable< TKey, TValue >::operator[](const TKey& key)
+  {
+    auto desired = emplace(key, TValue());
+    return (*(desired.first)).second;
+  }
+
+  template< class TKey, class TValue >
+  TValue& OpenHashTable< TKey, TValue >::operator[](TKey&& key)
+  {
+    return operator[](key);
+  }
+
+  template< class TKey, class TValue >
+  TValue& OpenHashTable< TKey, TValue >::at(const TKey& key)
+  {
+    TValue* value = findValue(key);
+    if (!value)
+    {
+      throw std::out_of_range("There are not value with specific key");
+    }
+    return *value;
+  }
+
+  template< class TKey, class TValue >
+  const TValue& OpenHashTable< TKey, TValue >::at(const TKey& key) const
+  {
+    const TValue* value = findValue(key);
+    if (!value)
+    {
+      throw std::out_of_range("There are not value with specific key");
+    }
+    return *value;
+  }
+
+  template< class TKey, class TValue >
+  bool OpenHashTable< TKey, TValue >::isEmpty() const noexcept
+  {
+    return count_ == 0;
+  }
+
+  template< class TKey, class TValue >
+  size_t OpenHashTable< TKey, TValue >::size() const noexcept
+  {
+    return count_;
+  }
+
+  template< class TKey, class TValue >
+  size_t OpenHashTable< TKey, TValue >::bucketCount() const noexcept
+  {
+    return capacity_;
+  }
+
+  template< class TKey, class TValue >
+  void OpenHashTable< TKey, TValue >::rehash(size_t count)
+  {
+    size_t newCapacity = MIN_CAPACITY_;
+    while ((newCapacity < count) || ((newCapacity - newCapacity / 8) <= count_))
+    {
+      newCapacity *= 2;
+    }
+    if ((newCapacity == capacity_) && (!nDeleted_))
+    {
+      return;
+    }
+
+    signed char* newCtrl = new signed char[newCapacity];
+    std::memset(newCtrl, detail::CTRL_EMPTY, newCapacity);
+    ValueType* newSlots = nullptr;
+    try
+    {
+      newSlots = static_cast< ValueType* >(::operator new(newCapacity * sizeof(ValueType)));
+    }
+    catch (...)
+    {
+      delete[] newCtrl;
+      throw;
+    }
+
+    signed char* oldCtrl = ctrl_;
+    ValueType* oldSlots = slots_;
+    size_t oldCapacity = capacity_;
+    ctrl_ = newCtrl;
+    slots_ = newSlots;
+    capacity_ = newCapacity;
+    nDeleted_ = 0;
+    for (size_t i = 0; i < oldCapacity; ++i)
+    {
+      if (detail::isFull(oldCtrl[i]))
+      {
+        size_t hash = calculateHash(oldSlots[i].first);
+        size_t index = findFreeIndex(hash);
+        new (slots_ + index) ValueType(std::move(oldSlots[i]));
+        ctrl_[index] = static_cast< signed char >(hash & 0x7F);
+        oldSlots[i].~ValueType();
+      }
+    }
+    delete[] oldCtrl;
+    ::operator delete(oldSlots);
+  }
+
+  template< class TKey, class TValue >
+  std::pair< OpenHashTableIterator< TKey, TValue >, bool > OpenHashTable< TKey, TValue >::insert(
+    const TKey& key, const TValue& value
+  )
+  {
+    return emplace(key, value);
+  }
+
+  template< class TKey, class TValue >
+  std::pair< OpenHashTableIterator< TKey, TValue >, bool > OpenHashTable< TKey, TValue >::insert(
+    const TKey& key, TValue&& value
+  )
+  {
+    return emplace(key, std::move(value));
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::erase(Iterator pos)
+  {
+    size_t index = pos.index_;
+    slots_[index].~ValueType();
+    size_t groupStart = index - index % detail::GROUP_WIDTH;
+    if (detail::ControlGroup(ctrl_ + groupStart).matchEmpty())
+    {
+      ctrl_[index] = detail::CTRL_EMPTY;
+    }
+    else
+    {
+      ctrl_[index] = detail::CTRL_DELETED;
+      ++nDeleted_;
+    }
+    --count_;
+    return Iterator(ctrl_, slots_, index + 1, capacity_);
+  }
+
+  template< class TKey, class TValue >
+  bool OpenHashTable< TKey, TValue >::erase(const TKey& key)
+  {
+    auto it = find(key);
+    if (it != end())
+    {
+      erase(it);
+      return true;
+    }
+    return false;
+  }
+
+  template< class TKey, class TValue >
+  void OpenHashTable< TKey, TValue >::swap(OpenHashTable< TKey, TValue >& other) noexcept
+  {
+    std::swap(ctrl_, other.ctrl_);
+    std::swap(slots_, other.slots_);
+    std::swap(count_, other.count_);
+    std::swap(nDeleted_, other.nDeleted_);
+    std::swap(capacity_, other.capacity_);
+  }
+
+  template< class TKey, class TValue >
+  void OpenHashTable< TKey, TValue >::clear() noexcept
+  {
+    for (size_t i = 0; i < capacity_; ++i)
+    {
+      if (detail::isFull(ctrl_[i]))
+      {
+        slots_[i].~ValueType();
+      }
+    }
+    if (capacity_)
+    {
+      std::memset(ctrl_, detail::CTRL_EMPTY, capacity_);
+    }
+    count_ = 0;
+    nDeleted_ = 0;
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::find(const TKey& key)
+  {
+    return Iterator(ctrl_, slots_, findIndex(key, calculateHash(key)), capacity_);
+  }
+
+  template< class TKey, class TValue >
+  ConstOpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::find(const TKey& key) const
+  {
+    return ConstIterator(ctrl_, slots_, findIndex(key, calculateHash(key)), capacity_);
+  }
+
+  template< class TKey, class TValue >
+  TValue* OpenHashTable< TKey, TValue >::findValue(const TKey& key)
+  {
+    size_t index = findIndex(key, calculateHash(key));
+    return (index == capacity_) ? nullptr : &slots_[index].second;
+  }
+
+  template< class TKey, class TValue >
+  const TValue* OpenHashTable< TKey, TValue >::findValue(const TKey& key) const
+  {
+    size_t index = findIndex(key, calculateHash(key));
+    return (index == capacity_) ? nullptr : &slots_[index].second;
+  }
+
+  template< class TKey, class TValue >
+  template< class K >
+  const TValue* OpenHashTable< TKey, TValue >::findEquivalent(const K& key) const
+  {
+    size_t index = findIndex(key, calculateHash(key));
+    return (index == capacity_) ? nullptr : &slots_[index].second;
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::begin() noexcept
+  {
+    return Iterator(ctrl_, slots_, 0, capacity_);
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::end() noexcept
+  {
+    return Iterator(ctrl_, slots_, capacity_, capacity_);
+  }
+
+  template< class TKey, class TValue >
+  ConstOpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::cbegin() const noexcept
+  {
+    return ConstIterator(ctrl_, slots_, 0, capacity_);
+  }
+
+  template< class TKey, class TValue >
+  ConstOpenHashTableIterator< TKey, TValue > OpenHashTable< TKey, TValue >::cend() const noexcept
+  {
+    return ConstIterator(ctrl_, slots_, capacity_, capacity_);
+  }
+
+  template< class TKey, class TValue >
+  template< class K >
+  size_t OpenHashTable< TKey, TValue >::calculateHash(const K& key)
+  {
+    return detail::mixHash(std::hash< K >()(key));
+  }
+
+  template< class TKey, class TValue >
+  size_t OpenHashTable< TKey, TValue >::maxLoad() const noexcept
+  {
+    return capacity_ - capacity_ / 8;
+  }
+
+  template< class TKey, class TValue >
+  template< class K >
+  size_t OpenHashTable< TKey, TValue >::findIndex(const K& key, size_t hash) const
+  {
+    if (!capacity_)
+    {
+      return capacity_;
+    }
+    size_t groupMask = capacity_ / detail::GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & groupMask;
+    signed char h2 = static_cast< signed char >(hash & 0x7F);
+    for (size_t step = 1; step <= groupMask + 1; ++step)
+    {
+      size_t groupStart = group * detail::GROUP_WIDTH;
+      detail::ControlGroup ctrl(ctrl_ + groupStart);
+      for (std::uint32_t mask = ctrl.match(h2); mask; mask &= mask - 1)
+      {
+        size_t index = groupStart + detail::countTrailingZeros(mask);
+        if (slots_[index].first == key)
+        {
+          return index;
+        }
+      }
+      if (ctrl.matchEmpty())
+      {
+        break;
+      }
+      group = (group + step) & groupMask;
+    }
+    return capacity_;
+  }
+
+  template< class TKey, class TValue >
+  size_t OpenHashTable< TKey, TValue >::findFreeIndex(size_t hash) const
+  {
+    size_t groupMask = capacity_ / detail::GROUP_WIDTH - 1;
+    size_t group = (hash >> 7) & groupMask;
+    for (size_t step = 1;; ++step)
+    {
+      size_t groupStart = group * detail::GROUP_WIDTH;
+      std::uint32_t mask = detail::ControlGroup(ctrl_ + groupStart).matchFree();
+      if (mask)
+      {
+        return groupStart + detail::countTrailingZeros(mask);
+      }
+      group = (group + step) & groupMask;
+    }
+  }
+
+  template< class TKey, class TValue >
+  template< class V >
+  std::pair< OpenHashTableIterator< TKey, TValue >, bool > OpenHashTable< TKey, TValue >::emplace(
+    const TKey& key, V&& value
+  )
+  {
+    size_t hash = calculateHash(key);
+    size_t index = findIndex(key, hash);
+    if (index != capacity_)
+    {
+      return std::pair< Iterator, bool >(Iterator(ctrl_, slots_, index, capacity_), false);
+    }
+    if ((count_ + nDeleted_ + 1) > maxLoad())
+    {
+      rehash(((count_ + 1) * 2 <= maxLoad()) ? capacity_ : capacity_ * 2);
+    }
+    index = findFreeIndex(hash);
+    new (slots_ + index) ValueType(key, std::forward< V >(value));
+    if (ctrl_[index] == detail::CTRL_DELETED)
+    {
+      --nDeleted_;
+    }
+    ctrl_[index] = static_cast< signed char >(hash & 0x7F);
+    ++count_;
+    return std::pair< Iterator, bool >(Iterator(ctrl_, slots_, index, capacity_), true);
+  }
+}
+
+#endif
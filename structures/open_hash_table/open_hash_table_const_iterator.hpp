@@ -0,0 +1,110 @@
+#ifndef CONST_OPEN_HASH_TABLE_ITERATOR_HPP
+#define CONST_OPEN_HASH_TABLE_ITERATOR_HPP
+#include <iterator>
+#include <utility>
+#include "control_group.hpp"
+#include "open_hash_table_iterator.hpp"
+
+namespace babinov
+{
+  template< class TKey, class TValue >
+  class OpenHashTable;
+
+  template< class TKey, class TValue >
+  class OpenHashTableIterator;
+
+  template< class TKey, class TValue >
+  class ConstOpenHashTableIterator: public std::iterator< std::forward_iterator_tag, std::pair< const TKey, TValue > >
+  {
+    friend class OpenHashTable< TKey, TValue >;
+  public:
+    using ValueType = std::pair< const TKey, TValue >;
+    using ThisType = ConstOpenHashTableIterator< TKey, TValue >;
+
+    ConstOpenHashTableIterator(const signed char* ctrl, const ValueType* slots, size_t index, size_t capacity):
+      ctrl_(ctrl),
+      slots_(slots),
+      index_(index),
+      capacity_(capacity)
+    {
+      skipFree();
+    }
+
+    explicit ConstOpenHashTableIterator(OpenHashTableIterator< TKey, TValue > iter):
+      ctrl_(iter.ctrl_),
+      slots_(iter.slots_),
+      index_(iter.index_),
+      capacity_(iter.capacity_)
+    {}
+
+    ~ConstOpenHashTableIterator() = default;
+    ConstOpenHashTableIterator(const ThisType&) = default;
+    ThisType& operator=(const ThisType&) = default;
+
+    bool operator==(const ThisType&) const;
+    bool operator!=(const ThisType&) const;
+    const ValueType& operator*() const;
+    const ValueType* operator->() const;
+    ThisType& operator++();
+    ThisType operator++(int);
+
+  private:
+    const signed char* ctrl_;
+    const ValueType* slots_;
+    size_t index_;
+    size_t capacity_;
+
+    void skipFree() noexcept;
+  };
+
+  template< class TKey, class TValue >
+  bool ConstOpenHashTableIterator< TKey, TValue >::operator==(const ThisType& other) const
+  {
+    return index_ == other.index_;
+  }
+
+  template< class TKey, class TValue >
+  bool ConstOpenHashTableIterator< TKey, TValue >::operator!=(const ThisType& other) const
+  {
+    return !(*this == other);
+  }
+
+  template< class TKey, class TValue >
+  const std::pair< const TKey, TValue >& ConstOpenHashTableIterator< TKey, TValue >::operator*() const
+  {
+    return slots_[index_];
+  }
+
+  template< class TKey, class TValue >
+  const std::pair< const TKey, TValue >* ConstOpenHashTableIterator< TKey, TValue >::operator->() const
+  {
+    return &(**this);
+  }
+
+  template< class TKey, class TValue >
+  ConstOpenHashTableIterator< TKey, TValue >& ConstOpenHashTableIterator< TKey, TValue >::operator++()
+  {
+    ++index_;
+    skipFree();
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  ConstOpenHashTableIterator< TKey, TValue > ConstOpenHashTableIterator< TKey, TValue >::operator++(int)
+  {
+    ThisType temp(*this);
+    operator++();
+    return temp;
+  }
+
+  template< class TKey, class TValue >
+  void ConstOpenHashTableIterator< TKey, TValue >::skipFree() noexcept
+  {
+    while ((index_ < capacity_) && (!detail::isFull(ctrl_[index_])))
+    {
+      ++index_;
+    }
+  }
+}
+
+#endif
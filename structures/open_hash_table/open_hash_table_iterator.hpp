@@ -0,0 +1,103 @@
+#ifndef OPEN_HASH_TABLE_ITERATOR_HPP
+#define OPEN_HASH_TABLE_ITERATOR_HPP
+#include <iterator>
+#include <utility>
+#include "control_group.hpp"
+
+namespace babinov
+{
+  template< class TKey, class TValue >
+  class OpenHashTable;
+
+  template< class TKey, class TValue >
+  class ConstOpenHashTableIterator;
+
+  template< class TKey, class TValue >
+  class OpenHashTableIterator: public std::iterator< std::forward_iterator_tag, std::pair< const TKey, TValue > >
+  {
+    friend class OpenHashTable< TKey, TValue >;
+    friend class ConstOpenHashTableIterator< TKey, TValue >;
+  public:
+    using ValueType = std::pair< const TKey, TValue >;
+    using ThisType = OpenHashTableIterator< TKey, TValue >;
+
+    OpenHashTableIterator(const signed char* ctrl, ValueType* slots, size_t index, size_t capacity):
+      ctrl_(ctrl),
+      slots_(slots),
+      index_(index),
+      capacity_(capacity)
+    {
+      skipFree();
+    }
+
+    ~OpenHashTableIterator() = default;
+    OpenHashTableIterator(const ThisType&) = default;
+    ThisType& operator=(const ThisType&) = default;
+
+    bool operator==(const ThisType&) const;
+    bool operator!=(const ThisType&) const;
+    ValueType& operator*() const;
+    ValueType* operator->() const;
+    ThisType& operator++();
+    ThisType operator++(int);
+
+  private:
+    const signed char* ctrl_;
+    ValueType* slots_;
+    size_t index_;
+    size_t capacity_;
+
+    void skipFree() noexcept;
+  };
+
+  template< class TKey, class TValue >
+  bool OpenHashTableIterator< TKey, TValue >::operator==(const ThisType& other) const
+  {
+    return index_ == other.index_;
+  }
+
+  template< class TKey, class TValue >
+  bool OpenHashTableIterator< TKey, TValue >::operator!=(const ThisType& other) const
+  {
+    return !(*this == other);
+  }
+
+  template< class TKey, class TValue >
+  std::pair< const TKey, TValue >& OpenHashTableIterator< TKey, TValue >::operator*() const
+  {
+    return slots_[index_];
+  }
+
+  template< class TKey, class TValue >
+  std::pair< const TKey, TValue >* OpenHashTableIterator< TKey, TValue >::operator->() const
+  {
+    return &(**this);
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTableIterator< TKey, TValue >& OpenHashTableIterator< TKey, TValue >::operator++()
+  {
+    ++index_;
+    skipFree();
+    return *this;
+  }
+
+  template< class TKey, class TValue >
+  OpenHashTableIterator< TKey, TValue > OpenHashTableIterator< TKey, TValue >::operator++(int)
+  {
+    ThisType temp(*this);
+    operator++();
+    return temp;
+  }
+
+  template< class TKey, class TValue >
+  void OpenHashTableIterator< TKey, TValue >::skipFree() noexcept
+  {
+    while ((index_ < capacity_) && (!detail::isFull(ctrl_[index_])))
+    {
+      ++index_;
+    }
+  }
+}
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef VECTOR_HPP
 #define VECTOR_HPP
 #include <initializer_list>
+#include <new>
 #include <utility>
 
 namespace babinov
@@ -20,33 +21,48 @@ namespace babinov
     T& operator[](size_t pos);
     const T& operator[](size_t pos) const;
 
+    T* data() noexcept;
+    const T* data() const noexcept;
     size_t size() const noexcept;
     size_t capacity() const noexcept;
     bool isEmpty() const noexcept;
 
+    void reserve(size_t capacity);
+    void shrinkToFit();
     void swap(Vector& other) noexcept;
     void pushBack(const T& value);
+    void pushBack(T&& value);
+    template< class... Args >
+    T& emplaceBack(Args&&... args);
+    void popBack() noexcept;
+    void insert(size_t pos, T value);
+    void erase(size_t pos);
     void clear() noexcept;
 
   private:
     static const size_t DEFAULT_CAPACITY_ = 3;
-    T** elements_;
+    T* elements_;
     size_t size_;
     size_t capacity_;
+
+    static T* allocate(size_t capacity);
+    static void deallocate(T* elements) noexcept;
+    void relocate(T* newElements);
+    void reallocate(size_t capacity);
   };
 
   template< class T >
   Vector< T >::Vector():
+    elements_(allocate(DEFAULT_CAPACITY_)),
     size_(0),
-    capacity_(DEFAULT_CAPACITY_),
-    elements_(new T*[DEFAULT_CAPACITY_] {nullptr})
+    capacity_(DEFAULT_CAPACITY_)
   {}
 
   template< class T >
   Vector< T >::Vector(const std::initializer_list< T >& init):
+    elements_(allocate(init.size())),
     size_(0),
-    capacity_(init.size()),
-    elements_(new T* [init.size()]{nullptr})
+    capacity_(init.size())
   {
     for (auto it = init.begin(); it != init.end(); ++it)
     {
@@ -56,32 +72,41 @@ namespace babinov
 
   template< class T >
   Vector< T >::Vector(const Vector& other):
-    size_(other.size_),
-    capacity_(other.size_ + 1),
-    elements_(new T*[other.size_ + 1] {nullptr})
+    elements_(allocate(other.size_ + 1)),
+    size_(0),
+    capacity_(other.size_ + 1)
   {
-    for (size_t i = 0; i < other.size_; ++i)
+    try
+    {
+      for (; size_ < other.size_; ++size_)
+      {
+        new (elements_ + size_) T(other.elements_[size_]);
+      }
+    }
+    catch (...)
     {
-      elements_[i] = new T(*other.elements_[i]);
+      clear();
+      deallocate(elements_);
+      throw;
     }
   }
 
   template< class T >
   Vector< T >::Vector(Vector&& other) noexcept:
+    elements_(other.elements_),
     size_(other.size_),
-    capacity_(other.size_ + 1),
-    elements_(other.elements_)
+    capacity_(other.capacity_)
   {
-    other.size_ = 0;
-    other.capacity_ = DEFAULT_CAPACITY_;
     other.elements_ = nullptr;
+    other.size_ = 0;
+    other.capacity_ = 0;
   }
 
   template< class T >
   Vector< T >::~Vector()
   {
     clear();
-    delete[] elements_;
+    deallocate(elements_);
   }
 
   template< class T >
@@ -109,13 +134,25 @@ namespace babinov
   template< class T >
   T& Vector< T >::operator[](size_t pos)
   {
-    return *elements_[pos];
+    return elements_[pos];
   }
 
   template< class T >
   const T& Vector< T >::operator[](size_t pos) const
   {
-    return *elements_[pos];
+    return elements_[pos];
+  }
+
+  template< class T >
+  T* Vector< T >::data() noexcept
+  {
+    return elements_;
+  }
+
+  template< class T >
+  const T* Vector< T >::data() const noexcept
+  {
+    return elements_;
   }
 
   template< class T >
@@ -136,32 +173,105 @@ namespace babinov
     return size_ == 0;
   }
 
+  template< class T >
+  void Vector< T >::reserve(size_t capacity)
+  {
+    if (capacity > capacity_)
+    {
+      reallocate(capacity);
+    }
+  }
+
+  template< class T >
+  void Vector< T >::shrinkToFit()
+  {
+    if (size_ < capacity_)
+    {
+      reallocate(size_);
+    }
+  }
+
   template< class T >
   void Vector< T >::swap(Vector& other) noexcept
   {
+    std::swap(elements_, other.elements_);
     std::swap(size_, other.size_);
     std::swap(capacity_, other.capacity_);
-    std::swap(elements_, other.elements_);
   }
 
   template< class T >
   void Vector< T >::pushBack(const T& value)
+  {
+    emplaceBack(value);
+  }
+
+  template< class T >
+  void Vector< T >::pushBack(T&& value)
+  {
+    emplaceBack(std::move(value));
+  }
+
+  template< class T >
+  template< class... Args >
+  T& Vector< T >::emplaceBack(Args&&... args)
   {
     if (size_ == capacity_)
     {
-      size_t size = size_;
-      T** newElements = new T*[capacity_ * 2] {nullptr};
-      for (size_t i = 0; i < size; ++i)
+      size_t newCapacity = capacity_ ? capacity_ * 2 : DEFAULT_CAPACITY_;
+      T* newElements = allocate(newCapacity);
+      try
       {
-        newElements[i] = new T(*elements_[i]);
+        new (newElements + size_) T(std::forward< Args >(args)...);
+        try
+        {
+          relocate(newElements);
+        }
+        catch (...)
+        {
+          newElements[size_].~T();
+          throw;
+        }
       }
-      clear();
-      size_ = size;
-      capacity_ *= 2;
+      catch (...)
+      {
+        deallocate(newElements);
+        throw;
+      }
+      deallocate(elements_);
       elements_ = newElements;
+      capacity_ = newCapacity;
+    }
+    else
+    {
+      new (elements_ + size_) T(std::forward< Args >(args)...);
     }
-    elements_[size_] = new T(value);
-    ++size_;
+    return elements_[size_++];
+  }
+
+  template< class T >
+  void Vector< T >::popBack() noexcept
+  {
+    elements_[--size_].~T();
+  }
+
+  template< class T >
+  void Vector< T >::insert(size_t pos, T value)
+  {
+    emplaceBack(std::move(value));
+    for (size_t i = size_ - 1; i > pos; --i)
+    {
+      std::swap(elements_[i], elements_[i - 1]);
+    }
+  }
+
+  template< class T >
+  void Vector< T >::erase(size_t pos)
+  {
+    for (size_t i = pos + 1; i < size_; ++i)
+    {
+      elements_[i - 1] = std::move(elements_[i]);
+    }
+    popBack();
   }
 
   template< class T >
@@ -169,10 +279,69 @@ namespace babinov
   {
     for (size_t i = 0; i < size_; ++i)
     {
-      delete elements_[i];
+      elements_[i].~T();
     }
     size_ = 0;
   }
+
+  template< class T >
+  T* Vector< T >::allocate(size_t capacity)
+  {
+    if (!capacity)
+    {
+      return nullptr;
+    }
+    return static_cast< T* >(::operator new(capacity * sizeof(T)));
+  }
+
+  template< class T >
+  void Vector< T >::deallocate(T* elements) noexcept
+  {
+    ::operator delete(elements);
+  }
+
+  template< class T >
+  void Vector< T >::relocate(T* newElements)
+  {
+    size_t i = 0;
+    try
+    {
+      for (; i < size_; ++i)
+      {
+        new (newElements + i) T(std::move_if_noexcept(elements_[i]));
+      }
+    }
+    catch (...)
+    {
+      for (size_t j = 0; j < i; ++j)
+      {
+        newElements[j].~T();
+      }
+      throw;
+    }
+    for (size_t j = 0; j < size_; ++j)
+    {
+      elements_[j].~T();
+    }
+  }
+
+  template< class T >
+  void Vector< T >::reallocate(size_t capacity)
+  {
+    T* newElements = allocate(capacity);
+    try
+    {
+      relocate(newElements);
+    }
+    catch (...)
+    {
+      deallocate(newElements);
+      throw;
+    }
+    deallocate(elements_);
+    elements_ = newElements;
+    capacity_ = capacity;
+  }
 }
 
 #endif
@@ -0,0 +1,112 @@
+#include "tests.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <string>
+#include "b_plus_tree.hpp"
+
+template< class TKey, class TValue >
+void print(const babinov::BPlusTree< TKey, TValue >& tree)
+{
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it)
+  {
+    std::cout << (*it).first << " (" << (*it).second << ") ";
+  }
+  std::cout << "| SIZE: " << tree.size() << '\n';
+}
+
+template< class TKey, class TValue >
+bool isSame(const babinov::BPlusTree< TKey, TValue >& tree, const std::map< TKey, TValue >& expected)
+{
+  if (tree.size() != expected.size())
+  {
+    return false;
+  }
+  auto expectedIt = expected.cbegin();
+  for (auto it = tree.cbegin(); it != tree.cend(); ++it, ++expectedIt)
+  {
+    if (((*it).first != expectedIt->first) || ((*it).second != expectedIt->second))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void testBPlusTree()
+{
+  using namespace babinov;
+
+  BPlusTree< std::string, int > ages;
+  std::cout << ages.isEmpty() << ' ' << (ages.begin() == ages.end()) << '\n';
+
+  std::cout << "-------- INSERTION TEST: --------\n\n";
+
+  auto res = ages.insert("Sonic", 15);
+  std::cout << res.second << ' ' << (*res.first).first << ' ' << (*res.first).second << '\n';
+  res = ages.insert("Sonic", 16);
+  std::cout << res.second << ' ' << (*res.first).first << ' ' << (*res.first).second << '\n';
+  ages["Tails"] = 8;
+  ages["Knuckles"] = 16;
+  ages["Amy Rose"] = 12;
+  print(ages);
+
+  std::cout << "-------- SEARCH TEST: --------\n\n";
+
+  std::cout << ages.at("Tails") << ' ' << (ages.find("Eggman") == ages.end()) << '\n';
+  std::cout << (*ages.lowerBound("B")).first << ' ' << (*ages.upperBound("Knuckles")).first << '\n';
+  std::cout << (ages.lowerBound("Z") == ages.end()) << '\n';
+  try
+  {
+    ages.at("Eggman");
+  }
+  catch (const std::out_of_range& e)
+  {
+    std::cout << e.what() << '\n';
+  }
+
+  std::cout << "-------- COPYING AND DELETING TEST: --------\n\n";
+
+  BPlusTree< std::string, int > agesCopy(ages);
+  std::cout << ages.erase("Tails") << ' ' << ages.erase("Tails") << '\n';
+  print(ages);
+  print(agesCopy);
+  BPlusTree< std::string, int > agesMoved(std::move(agesCopy));
+  agesCopy = agesMoved;
+  print(agesCopy);
+
+  std::cout << "-------- CONSISTENCY TEST: --------\n\n";
+
+  BPlusTree< int, int > tree;
+  std::map< int, int > expected;
+  std::srand(42);
+  bool isConsistent = true;
+  for (int i = 0; i < 200000; ++i)
+  {
+    int key = std::rand() % 20000;
+    if (std::rand() % 3)
+    {
+      tree[key] = i;
+      expected[key] = i;
+    }
+    else
+    {
+      isConsistent = isConsistent && (tree.erase(key) == (expected.erase(key) == 1));
+    }
+  }
+  std::cout << isConsistent << ' ' << isSame(tree, expected) << '\n';
+  size_t nInRange = 0;
+  for (auto it = tree.lowerBound(100); (it != tree.end()) && ((*it).first <= 200); ++it)
+  {
+    ++nInRange;
+  }
+  auto from = expected.lower_bound(100);
+  auto to = expected.upper_bound(200);
+  std::cout << (nInRange == static_cast< size_t >(std::distance(from, to))) << '\n';
+  for (int key = 0; key < 20000; ++key)
+  {
+    tree.erase(key);
+  }
+  std::cout << tree.size() << ' ' << (tree.begin() == tree.end()) << '\n';
+}
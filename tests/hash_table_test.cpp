@@ -2,6 +2,7 @@
 #include <iostream>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include "hash_table.hpp"
 
 struct CharacterInfo
@@ -145,6 +146,11 @@ void testHashTable()
   {
     std::cout << e.what() << '\n';
   }
+  const auto& constCharacters = characters;
+  std::cout << (characters.findValue("Dark oak") == nullptr) << ' ';
+  std::cout << (constCharacters.findValue("Sonic") == &characters.at("Sonic")) << ' ';
+  std::cout << (characters.findEquivalent(std::string_view("Sonic")) == &characters.at("Sonic")) << ' ';
+  std::cout << (characters.findEquivalent(std::string_view("Dark oak")) == nullptr) << '\n';
   std::cout << '\n';
 
   std::cout << "-------- COPYING AND MOVING TEST: --------\n\n";
@@ -214,4 +220,30 @@ void testHashTable()
   charactersCopy3.clear();
   print(charactersCopy3);
   std::cout << '\n';
+
+  std::cout << "-------- NODE ALLOCATION TEST: --------\n\n";
+
+  HashTable< std::string, size_t > pooled;
+  HashTable< std::string, size_t, HeapNodes > heap;
+  for (size_t round = 0; round < 2; ++round)
+  {
+    for (size_t i = 0; i < 1000; ++i)
+    {
+      pooled.insert(std::to_string(i), i);
+      heap.insert(std::to_string(i), i);
+    }
+    for (size_t i = 0; i < 1000; i += 2)
+    {
+      pooled.erase(std::to_string(i));
+      heap.erase(std::to_string(i));
+    }
+    size_t nMatched = 0;
+    for (auto it = heap.cbegin(); it != heap.cend(); ++it)
+    {
+      nMatched += pooled.at((*it).first) == (*it).second;
+    }
+    std::cout << pooled.size() << ' ' << heap.size() << ' ' << nMatched << '\n';
+    pooled.clear();
+    heap.clear();
+  }
 }
@@ -6,29 +6,21 @@
 #include <utility>
 #include "vector.hpp"
 #include "hash_table.hpp"
+#include "open_hash_table.hpp"
 
-void testHashTableTime()
-{
-  using namespace babinov;
+const size_t N_ROWS_TO_CONSIDER = 10000;
+const size_t N_ROWS_TO_INSERT = 100000;
 
-  const size_t N_ROWS_TO_CONSIDER = 10000;
-  const size_t N_ROWS_TO_INSERT = 100000;
-  std::ifstream file("hash_table_test_data.txt");
-  Vector< std::pair< size_t, std::string > > data;
-  std::pair< size_t, std::string > row;
-  for (size_t i = 0; i < N_ROWS_TO_CONSIDER + N_ROWS_TO_INSERT; ++i)
-  {
-    file >> row.first >> row.second;
-    data.pushBack(row);
-  }
-  file.close();
-
-  HashTable< size_t, std::string > table;
+template< class Table >
+long long measureTime(const babinov::Vector< std::pair< size_t, std::string > >& data)
+{
+  Table table;
   for (size_t i = 0; i < N_ROWS_TO_INSERT; ++i)
   {
     table.insert(data[i].first, data[i].second);
   }
 
+  size_t nFound = 0;
   auto timeBegin = std::chrono::steady_clock::now();
 #ifdef INSERTION_MODE
   for (size_t i = 0; i < 2; ++i)
@@ -43,11 +35,11 @@ void testHashTableTime()
 #ifdef SEARCH_MODE
   for (int i = N_ROWS_TO_CONSIDER / 2; i >= 0; --i)
   {
-    table.find(data[i].first);
+    nFound += (table.find(data[i].first) != table.end());
   }
   for (size_t i = N_ROWS_TO_INSERT; i < (N_ROWS_TO_INSERT + N_ROWS_TO_CONSIDER / 2); ++i)
   {
-    table.find(data[i].first);
+    nFound += (table.find(data[i].first) != table.end());
   }
 #endif
 
@@ -58,6 +50,28 @@ void testHashTableTime()
   }
 #endif
   auto timeEnd = std::chrono::steady_clock::now();
-  auto elapsedTime = std::chrono::duration_cast< std::chrono::milliseconds >(timeEnd - timeBegin);
-  std::cout << "The time: " << elapsedTime.count() << " ms" << '\n';
+  auto elapsedTime = std::chrono::duration_cast< std::chrono::microseconds >(timeEnd - timeBegin);
+  std::cout << "Found: " << nFound << '\n';
+  return elapsedTime.count();
+}
+
+void testHashTableTime()
+{
+  using namespace babinov;
+
+  std::ifstream file("hash_table_test_data.txt");
+  Vector< std::pair< size_t, std::string > > data;
+  data.reserve(N_ROWS_TO_CONSIDER + N_ROWS_TO_INSERT);
+  std::pair< size_t, std::string > row;
+  for (size_t i = 0; i < N_ROWS_TO_CONSIDER + N_ROWS_TO_INSERT; ++i)
+  {
+    file >> row.first >> row.second;
+    data.pushBack(row);
+  }
+  file.close();
+
+  long long chainedTime = measureTime< HashTable< size_t, std::string > >(data);
+  long long openTime = measureTime< OpenHashTable< size_t, std::string > >(data);
+  std::cout << "HashTable (chaining): " << chainedTime << " us" << '\n';
+  std::cout << "OpenHashTable (open addressing): " << openTime << " us" << '\n';
 }
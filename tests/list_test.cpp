@@ -1,5 +1,6 @@
 #include "tests.hpp"
 #include <iostream>
+#include <string>
 #include <utility>
 #include "list.hpp"
 
@@ -99,4 +100,29 @@ void testList()
 
   list3.clear();
   print(list3);
+
+  std::cout << "\n-------- NODE ALLOCATION TEST: --------\n\n";
+
+  List< std::string > pooled;
+  List< std::string, HeapNodes > heap;
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    pooled.pushBack(std::to_string(i));
+    heap.pushBack(std::to_string(i));
+    if (i % 3 == 0)
+    {
+      pooled.popFront();
+      heap.popFront();
+    }
+  }
+  bool isEqual = pooled.size() == heap.size();
+  for (auto lhs = pooled.cbegin(), rhs = heap.cbegin(); isEqual && (lhs != pooled.cend()); ++lhs, ++rhs)
+  {
+    isEqual = *lhs == *rhs;
+  }
+  std::cout << pooled.size() << ' ' << isEqual << ' ' << pooled.front() << ' ' << pooled.back() << '\n';
+  pooled.clear();
+  pooled.pushBack("reused");
+  List< std::string > moved(std::move(pooled));
+  std::cout << moved.size() << ' ' << moved.front() << '\n';
 }
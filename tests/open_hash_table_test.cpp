@@ -0,0 +1,116 @@
+#include "tests.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include "hash_table.hpp"
+#include "open_hash_table.hpp"
+
+template< class TKey, class TValue >
+void print(const babinov::OpenHashTable< TKey, TValue >& table)
+{
+  for (auto it = table.cbegin(); it != table.cend(); ++it)
+  {
+    std::cout << (*it).first << " (" << (*it).second << ')' << '\n';
+  }
+  std::cout << "SIZE: " << table.size() << '\n';
+  std::cout << "CAPACITY: " << table.bucketCount() << '\n';
+}
+
+template< class TKey, class TValue >
+bool isSame(const babinov::OpenHashTable< TKey, TValue >& table, const babinov::HashTable< TKey, TValue >& expected)
+{
+  if (table.size() != expected.size())
+  {
+    return false;
+  }
+  for (auto it = expected.cbegin(); it != expected.cend(); ++it)
+  {
+    auto desired = table.find((*it).first);
+    if ((desired == table.cend()) || ((*desired).second != (*it).second))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void testOpenHashTable()
+{
+  using namespace babinov;
+
+  OpenHashTable< std::string, int > ages;
+  std::cout << ages.isEmpty() << ' ' << (ages.begin() == ages.end()) << '\n';
+
+  std::cout << "-------- INSERTION TEST: --------\n\n";
+
+  auto res = ages.insert("Sonic", 15);
+  std::cout << res.second << ' ' << (*res.first).first << ' ' << (*res.first).second << '\n';
+  res = ages.insert("Sonic", 16);
+  std::cout << res.second << ' ' << (*res.first).first << ' ' << (*res.first).second << '\n';
+  ages["Tails"] = 8;
+  ages["Knuckles"] = 16;
+  print(ages);
+  std::cout << '\n';
+
+  std::cout << "-------- FIND AND ERASE TEST: --------\n\n";
+
+  std::cout << ages.at("Tails") << ' ' << (ages.find("Eggman") == ages.end()) << '\n';
+  try
+  {
+    ages.at("Eggman");
+  }
+  catch (const std::out_of_range& e)
+  {
+    std::cout << e.what() << '\n';
+  }
+  const OpenHashTable< std::string, int >& constAges = ages;
+  std::cout << *ages.findValue("Tails") << ' ' << (constAges.findValue("Eggman") == nullptr) << ' ';
+  std::cout << (OpenHashTable< std::string, int >().findValue("Tails") == nullptr) << ' ';
+  std::cout << *ages.findEquivalent(std::string_view("Tails")) << ' ';
+  std::cout << (constAges.findEquivalent(std::string_view("Eggman")) == nullptr) << '\n';
+  std::cout << ages.erase("Tails") << ' ' << ages.erase("Tails") << '\n';
+  print(ages);
+  std::cout << '\n';
+
+  std::cout << "-------- COPYING AND MOVING TEST: --------\n\n";
+
+  OpenHashTable< std::string, int > agesCopy(ages);
+  ages["Amy Rose"] = 12;
+  print(agesCopy);
+  OpenHashTable< std::string, int > agesMoved(std::move(ages));
+  std::cout << agesMoved.size() << ' ' << ages.size() << '\n';
+  agesCopy = agesMoved;
+  print(agesCopy);
+  std::cout << '\n';
+
+  std::cout << "-------- CONSISTENCY TEST: --------\n\n";
+
+  OpenHashTable< int, int > table;
+  HashTable< int, int > expected;
+  std::srand(42);
+  bool isConsistent = true;
+  for (int i = 0; i < 200000; ++i)
+  {
+    int key = std::rand() % 5000;
+    if (std::rand() % 3)
+    {
+      table[key] = i;
+      expected[key] = i;
+    }
+    else
+    {
+      isConsistent = isConsistent && (table.erase(key) == expected.erase(key));
+    }
+  }
+  std::cout << isConsistent << ' ' << isSame(table, expected) << '\n';
+  table.rehash(100000);
+  std::cout << isSame(table, expected) << ' ' << table.bucketCount() << '\n';
+  auto it = table.begin();
+  while (it != table.end())
+  {
+    it = table.erase(it);
+  }
+  std::cout << table.size() << ' ' << (table.find(1) == table.end()) << '\n';
+}
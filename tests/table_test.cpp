@@ -1,8 +1,18 @@
 #include "tests.hpp"
+#include <cstring>
+#include <fstream>
 #include <iostream>
+#include <sstream>
 #include <stdexcept>
 #include <string>
 #include "tables.hpp"
+#include "hash_join.hpp"
+#include "external_sort.hpp"
+#include "snapshot.hpp"
+#include "table_loader.hpp"
+#include "thread_pool.hpp"
+#include "value_parser.hpp"
+#include "write_ahead_log.hpp"
 #include "vector.hpp"
 
 void printRows(const babinov::Vector< babinov::Table::Row >& rows_)
@@ -229,4 +239,722 @@ void testTable()
   Table notes({ { "name", TEXT }, { "note", TEXT } });
   notes.insert({ "note1", "row1\nrow2\nrow3\n\n\n   row4   \n row5" });
   std::cout << notes;
+
+  std::cout << "\n-------- INDEX TEST: --------\n\n";
+
+  Table indexed({ { "name", TEXT }, { "age", INTEGER } });
+  indexed.insert({ "Jonh", "32" });
+  indexed.insert({ "Steve", "28" });
+  indexed.insert({ "Jonh", "25" });
+  indexed.createIndex("name");
+  indexed.insert({ "Jonh", "21" });
+  printRows(indexed.select("name", "Jonh"));
+  indexed.update(1, "name", "Carl");
+  printRows(indexed.select("name", "Jonh"));
+  printRows(indexed.select("name", "Carl"));
+  indexed.del("age", "25");
+  printRows(indexed.select("name", "Jonh"));
+  try
+  {
+    indexed.createIndex("name");
+  }
+  catch (const std::logic_error& e)
+  {
+    std::cerr << e.what() << '\n';
+  }
+  std::cout << indexed.dropIndex("name") << ' ' << indexed.dropIndex("name") << '\n';
+  printRows(indexed.select("name", "Jonh"));
+
+  std::cout << "\n-------- RANGE TEST: --------\n\n";
+
+  Table ranged({ { "name", TEXT }, { "amount", REAL } });
+  ranged.insert({ "a", "500" });
+  ranged.insert({ "b", "1500" });
+  ranged.insert({ "c", "1000" });
+  printRows(ranged.select(ranged.makeCondition("amount", GREATER_EQUAL, "1000")));
+  ranged.createIndex("amount", ORDERED_INDEX);
+  ranged.insert({ "d", "2500" });
+  printRows(ranged.select(ranged.makeCondition("amount", BETWEEN, "1000", "2000")));
+  ranged.update(3, "amount", "99");
+  printRows(ranged.select(ranged.makeCondition("amount", LESS, "1000")));
+  ranged.del(ranged.makeCondition("amount", GREATER, "1000"));
+  ranged.printRows(std::cout);
+
+  std::cout << "\n-------- LOAD TEST: --------\n\n";
+
+  {
+    std::ofstream file("table_load_test.txt");
+    file << ranged;
+  }
+  Table loaded = loadTable("table_load_test.txt");
+  loaded.printRows(std::cout);
+  loaded.insert({ "e", "7.5" });
+  printRows(loaded.select("id", "4"));
+  try
+  {
+    loadTable("missing_table_file.txt");
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cerr << e.what() << '\n';
+  }
+
+  std::cout << "\n-------- SNAPSHOT TEST: --------\n\n";
+
+  std::ostringstream snapshot;
+  loaded.writeSnapshot(snapshot);
+  Table restored;
+  restored.readSnapshot(snapshot.str().data(), snapshot.str().size());
+  restored.printRows(std::cout);
+  std::string corrupted = snapshot.str();
+  corrupted[corrupted.size() - 1] ^= 1;
+  try
+  {
+    restored.readSnapshot(corrupted.data(), corrupted.size());
+  }
+  catch (const std::invalid_argument& e)
+  {
+    std::cerr << e.what() << '\n';
+  }
+
+  std::cout << "\n-------- LOG TEST: --------\n\n";
+
+  {
+    WriteAheadLog log("table_log_test.wal", true);
+    log.setSyncPolicy(SYNC_OFF);
+    log.logInsert({ "a", "1.5" });
+    log.logInsert({ "b", "2.5" });
+    log.logUpdate(1, "amount", "3.5");
+    log.logDelete(Condition(2, REAL, GREATER, "3"));
+    log.logInsert({ "c", "4.5" });
+  }
+  Table replayed({ { "name", TEXT }, { "amount", REAL } });
+  std::cout << replayLog("table_log_test.wal", replayed, 0) << '\n';
+  replayed.printRows(std::cout);
+
+  std::cout << "\n-------- PARALLEL SCAN TEST: --------\n\n";
+
+  Table large({ { "value", INTEGER } });
+  for (size_t i = 0; i < 200000; ++i)
+  {
+    large.insert({ std::to_string(i % 1000) });
+  }
+  for (size_t nThreads = 1; nThreads <= 4; nThreads *= 2)
+  {
+    getScanPool().resize(nThreads);
+    Vector< Table::Row > selected = large.select(large.makeCondition("value", LESS, "10"));
+    std::cout << nThreads << ": " << selected.size() << ' ' << selected[0][0] << ' ';
+    std::cout << selected[selected.size() - 1][0] << '\n';
+  }
+  large.del(large.makeCondition("value", GREATER_EQUAL, "500"));
+  std::cout << large.size() << '\n';
+
+  std::cout << "\n-------- SIMD SCAN TEST: --------\n\n";
+
+  Table numbers({ { "whole", INTEGER }, { "fraction", REAL } });
+  for (int i = 0; i < 1000; ++i)
+  {
+    numbers.insert({ std::to_string(i - 500), std::to_string((i - 500) / 4.0) });
+  }
+  numbers.del(numbers.makeCondition("whole", BETWEEN, "0", "99"));
+  std::cout << numbers.count(numbers.makeCondition("whole", LESS, "0")) << ' ';
+  std::cout << numbers.count(numbers.makeCondition("whole", GREATER_EQUAL, "0")) << ' ';
+  std::cout << numbers.count(numbers.makeCondition("whole", GREATER, "2147483647")) << ' ';
+  std::cout << numbers.count(numbers.makeCondition("fraction", BETWEEN, "-0.25", "0.25")) << ' ';
+  std::cout << numbers.count(numbers.makeCondition("fraction", GREATER, "nan")) << ' ';
+  std::cout << numbers.count(numbers.makeCondition("fraction", BETWEEN, "1", "-1")) << '\n';
+  Vector< Table::Row > fractions = numbers.select(numbers.makeCondition("fraction", LESS, "-124.5"));
+  std::cout << fractions.size() << ' ' << fractions[0][1] << ' ' << fractions[fractions.size() - 1][2] << '\n';
+
+  std::cout << "\n-------- STREAMING SELECT TEST: --------\n\n";
+
+  size_t nVisited = 0;
+  numbers.forEach(numbers.makeCondition("whole", GREATER_EQUAL, "395"), [&](const Table::RowRef& row)
+  {
+    numbers.printRow(std::cout, row);
+    std::cout << ' ' << row.getId() << ' ' << row.getAsString(2) << ' ' << row.toRow()[1] << '\n';
+    return ++nVisited < 3;
+  });
+  nVisited = 0;
+  numbers.forEach(numbers.makeCondition("id", "1"), [&](const Table::RowRef& row)
+  {
+    nVisited += row.getColumn(1).getInteger(row.getSlot()) == -500;
+    return true;
+  });
+  std::cout << nVisited << '\n';
+
+  std::cout << "\n-------- AGGREGATE TEST: --------\n\n";
+
+  Vector< Aggregate > aggregates;
+  aggregates.pushBack({ COUNT, 0 });
+  aggregates.pushBack({ SUM, 1 });
+  aggregates.pushBack({ MIN, 2 });
+  aggregates.pushBack({ MAX, 2 });
+  aggregates.pushBack({ AVG, 1 });
+  Vector< Accumulator > totals = numbers.aggregate(aggregates);
+  Vector< Accumulator > filtered = numbers.aggregate(aggregates, numbers.makeCondition("whole", BETWEEN, "-10", "10"));
+  Vector< Accumulator > empty = numbers.aggregate(aggregates, numbers.makeCondition("id", "100000"));
+  for (size_t i = 0; i < aggregates.size(); ++i)
+  {
+    DataType dataType = numbers.getColumns()[aggregates[i].columnIndex].second;
+    printAggregate(std::cout, aggregates[i].function, dataType, totals[i]);
+    std::cout << ' ';
+    printAggregate(std::cout, aggregates[i].function, dataType, filtered[i]);
+    std::cout << ' ';
+    printAggregate(std::cout, aggregates[i].function, dataType, empty[i]);
+    std::cout << '\n';
+  }
+  try
+  {
+    Table texts({ { "text", TEXT } });
+    texts.aggregate({ { SUM, 1 } });
+  }
+  catch (const std::invalid_argument&)
+  {
+    std::cout << "Cannot aggregate text column\n";
+  }
+
+  std::cout << "\n-------- GROUP BY TEST: --------\n\n";
+
+  Table sales({ { "customer", TEXT }, { "amount", REAL }, { "region", INTEGER } });
+  for (size_t i = 0; i < 300000; ++i)
+  {
+    sales.insert({ "customer " + std::to_string(i % 3), std::to_string(i % 7), std::to_string(i % 2) });
+  }
+  Vector< Aggregate > rollup;
+  rollup.pushBack({ COUNT, 0 });
+  rollup.pushBack({ SUM, 2 });
+  rollup.pushBack({ MAX, 3 });
+  for (size_t nThreads = 1; nThreads <= 4; nThreads *= 2)
+  {
+    getScanPool().resize(nThreads);
+    Vector< Table::Group > groups = sales.groupBy(1, rollup);
+    std::cout << nThreads << ": ";
+    for (size_t i = 0; i < groups.size(); ++i)
+    {
+      std::cout << groups[i].key << ' ' << groups[i].accumulators[0].count << ' ';
+      std::cout << groups[i].accumulators[1].realSum << ' ' << groups[i].accumulators[2].integerMax << "; ";
+    }
+    std::cout << '\n';
+  }
+  Vector< Table::Group > regions = sales.groupBy(3, rollup, sales.makeCondition("amount", GREATER_EQUAL, "5"));
+  for (size_t i = 0; i < regions.size(); ++i)
+  {
+    std::cout << regions[i].key << ' ' << regions[i].accumulators[0].count << ' ' << regions[i].accumulators[1].realSum;
+    std::cout << '\n';
+  }
+  std::cout << sales.groupBy(2, rollup, sales.makeCondition("id", "7")).size() << '\n';
+
+  std::cout << "\n-------- JOIN TEST: --------\n\n";
+
+  Table customers({ { "name", TEXT }, { "region", INTEGER } });
+  customers.insert({ "ann", "1" });
+  customers.insert({ "bob", "2" });
+  customers.insert({ "cid", "1" });
+  Table orders({ { "customer", INTEGER }, { "amount", REAL } });
+  for (size_t i = 0; i < 200000; ++i)
+  {
+    orders.insert({ std::to_string(i % 5), std::to_string(i % 10) });
+  }
+  for (int mode = AUTO_JOIN; mode <= RADIX_JOIN; ++mode)
+  {
+    size_t nJoined = 0;
+    double total = 0.0;
+    hashJoin(customers, "id", orders, "customer", [&](const Table::RowRef& customer, const Table::RowRef& order)
+    {
+      ++nJoined;
+      total += order.getColumn(2).getReal(order.getSlot()) * customer.getId();
+      return true;
+    }, JoinMode(mode));
+    std::cout << mode << ": " << nJoined << ' ' << total << '\n';
+  }
+  hashJoin(customers, "region", customers, "region", [&](const Table::RowRef& lhs, const Table::RowRef& rhs)
+  {
+    customers.printRow(std::cout, lhs);
+    std::cout << ' ';
+    customers.printRow(std::cout, rhs);
+    std::cout << '\n';
+    return true;
+  });
+  size_t nFirst = 0;
+  hashJoin(orders, "customer", customers, "id", [&](const Table::RowRef&, const Table::RowRef&)
+  {
+    return ++nFirst < 10;
+  });
+  std::cout << nFirst << '\n';
+  try
+  {
+    hashJoin(customers, "name", orders, "amount", [](const Table::RowRef&, const Table::RowRef&)
+    {
+      return true;
+    });
+  }
+  catch (const std::invalid_argument&)
+  {
+    std::cout << "Incompatible join columns\n";
+  }
+
+  std::cout << "\n-------- ORDER BY TEST: --------\n\n";
+
+  Table scores({ { "player", TEXT }, { "score", REAL }, { "level", INTEGER } });
+  for (size_t i = 0; i < 50000; ++i)
+  {
+    scores.insert({ "p" + std::to_string(i % 997), std::to_string((i * 7919) % 1000 / 10.0), std::to_string(i % 13) });
+  }
+  scores.insert({ "nan", "nan", "0" });
+  auto checkOrder = [&](const Table::SortOrder& order, size_t limit)
+  {
+    size_t nRows = 0;
+    size_t checksum = 0;
+    std::string first;
+    std::string last;
+    scores.forEachSorted(order, limit, [&](const Table::RowRef& row)
+    {
+      last = row.getAsString(order.columnIndex);
+      first = nRows ? first : last;
+      checksum = checksum * 31 + row.getId();
+      ++nRows;
+      return true;
+    });
+    std::cout << nRows << ' ' << first << ' ' << last << ' ' << checksum << '\n';
+  };
+  for (size_t memoryLimit = DEFAULT_SORT_MEMORY_LIMIT; memoryLimit >= 4096; memoryLimit /= 4096)
+  {
+    setSortMemoryLimit(memoryLimit);
+    checkOrder({ 2, false }, 0);
+    checkOrder({ 2, true }, 0);
+    checkOrder({ 1, true }, 0);
+    checkOrder({ 3, false }, 0);
+    checkOrder({ 2, false }, 5);
+    checkOrder({ 1, false }, 1000);
+  }
+  setSortMemoryLimit(DEFAULT_SORT_MEMORY_LIMIT);
+  size_t nHigh = 0;
+  scores.forEachSorted(scores.makeCondition("level", GREATER_EQUAL, "12"), { 0, true }, 3, [&](const Table::RowRef& row)
+  {
+    scores.printRow(std::cout, row);
+    std::cout << '\n';
+    return ++nHigh < 2;
+  });
+
+  std::cout << "\n-------- COMPOUND CONDITION TEST: --------\n\n";
+
+  Table accounts({ { "owner", TEXT }, { "balance", REAL }, { "age", INTEGER } });
+  for (size_t i = 0; i < 150000; ++i)
+  {
+    accounts.insert({ "o" + std::to_string(i % 101), std::to_string((i * 37) % 1000 / 4.0), std::to_string(i % 90) });
+  }
+  Condition young = accounts.makeCondition("age", LESS, "30");
+  Condition rich = accounts.makeCondition("balance", GREATER_EQUAL, "200");
+  Condition owner = accounts.makeCondition("owner", EQUAL, "o7");
+  Condition middle = accounts.makeCondition("age", BETWEEN, "40", "49");
+  Vector< Condition > conditions;
+  conditions.pushBack(Condition(LOGICAL_AND, { young, rich }));
+  conditions.pushBack(Condition(LOGICAL_AND, { rich, owner, young }));
+  conditions.pushBack(Condition(LOGICAL_OR, { owner, middle }));
+  conditions.pushBack(Condition(LOGICAL_NOT, { Condition(LOGICAL_OR, { young, rich }) }));
+  conditions.pushBack(Condition(LOGICAL_OR, { Condition(LOGICAL_AND, { owner, rich }), Condition(LOGICAL_NOT, { middle }) }));
+  auto checkConditions = [&]()
+  {
+    for (size_t i = 0; i < conditions.size(); ++i)
+    {
+      size_t nVisited = 0;
+      size_t checksum = 0;
+      accounts.forEach(conditions[i], [&](const Table::RowRef& row)
+      {
+        ++nVisited;
+        checksum = checksum * 31 + row.getId();
+        return true;
+      });
+      std::cout << accounts.count(conditions[i]) << ' ' << accounts.select(conditions[i]).size() << ' ';
+      std::cout << nVisited << ' ' << checksum << '\n';
+    }
+  };
+  checkConditions();
+  accounts.createIndex("age", ORDERED_INDEX);
+  accounts.createIndex("owner");
+  checkConditions();
+  std::cout << accounts.planCondition(conditions[1]).getOperands()[0].getColumnIndex() << '\n';
+  std::cout << accounts.update(Condition(LOGICAL_AND, { owner, middle }), "balance", "-1") << '\n';
+  std::cout << accounts.count(accounts.makeCondition("balance", EQUAL, "-1")) << '\n';
+  std::cout << accounts.del(conditions[2]) << ' ' << accounts.size() << ' ' << accounts.count(conditions[2]) << '\n';
+  try
+  {
+    Condition(LOGICAL_NOT, { young, rich });
+  }
+  catch (const std::invalid_argument&)
+  {
+    std::cout << "Invalid logical condition\n";
+  }
+
+  std::cout << "\n-------- PROJECTION TEST: --------\n\n";
+
+  Table::Projection projection = accounts.makeProjection({ "age", "owner" });
+  Condition oldOwners(LOGICAL_AND, { accounts.makeCondition("age", GREATER, "88"),
+    accounts.makeCondition("owner", EQUAL, "o8"), accounts.makeCondition("balance", LESS, "100") });
+  printRows(accounts.select(oldOwners, projection));
+  size_t nProjected = 0;
+  accounts.forEachSorted(oldOwners, { 2, true }, 3, projection, [&](const Table::RowRef& row)
+  {
+    accounts.printRow(std::cout, row, projection);
+    std::cout << ' ' << row.toRow(accounts.makeProjection({ "id" }))[0] << '\n';
+    return ++nProjected < 3;
+  });
+  try
+  {
+    accounts.makeProjection({ "age", "nope" });
+  }
+  catch (const std::out_of_range&)
+  {
+    std::cout << "Column doesn't exist\n";
+  }
+
+  std::cout << "\n-------- PAGINATION TEST: --------\n\n";
+
+  auto paginate = [&](const Condition* condition, size_t pageSize)
+  {
+    size_t nPages = 0;
+    size_t nRows = 0;
+    size_t checksum = 0;
+    size_t cursor = 0;
+    bool hasMore = true;
+    while (hasMore)
+    {
+      size_t nPage = 0;
+      hasMore = false;
+      Table::RowVisitor visitor = [&](const Table::RowRef& row)
+      {
+        if (nPage == pageSize)
+        {
+          hasMore = true;
+          return false;
+        }
+        ++nPage;
+        checksum = checksum * 31 + row.getId();
+        cursor = row.getId();
+        return true;
+      };
+      condition ? accounts.forEachAfter(cursor, *condition, visitor) : accounts.forEachAfter(cursor, visitor);
+      nRows += nPage;
+      ++nPages;
+    }
+    std::cout << nPages << ' ' << nRows << ' ' << checksum << '\n';
+  };
+  auto scanAll = [&](const Condition* condition)
+  {
+    size_t nRows = 0;
+    size_t checksum = 0;
+    Table::RowVisitor visitor = [&](const Table::RowRef& row)
+    {
+      ++nRows;
+      checksum = checksum * 31 + row.getId();
+      return true;
+    };
+    condition ? accounts.forEach(*condition, visitor) : accounts.forEach(visitor);
+    std::cout << nRows << ' ' << checksum << '\n';
+  };
+  Condition youngOwners(LOGICAL_AND, { young, accounts.makeCondition("owner", EQUAL, "o8") });
+  Condition youngRich(LOGICAL_AND, { young, rich });
+  Condition ageRange = accounts.makeCondition("age", GREATER, "80");
+  paginate(nullptr, 7);
+  scanAll(nullptr);
+  paginate(&youngOwners, 3);
+  scanAll(&youngOwners);
+  paginate(&youngRich, 1000);
+  scanAll(&youngRich);
+  paginate(&ageRange, 50);
+  scanAll(&ageRange);
+  size_t resumed = 0;
+  accounts.forEachAfter(8, [&](const Table::RowRef& row)
+  {
+    resumed = row.getId();
+    return false;
+  });
+  std::cout << accounts.count(accounts.makeCondition("id", EQUAL, "8")) << ' ' << resumed << '\n';
+  size_t nResumed = 0;
+  accounts.forEachAfter(150000, [&](const Table::RowRef&)
+  {
+    return ++nResumed;
+  });
+  std::cout << nResumed << '\n';
+
+  std::cout << "\n-------- PREPARED CONDITION TEST: --------\n\n";
+
+  Condition byOwner = accounts.makeCondition("owner", EQUAL, "");
+  byOwner.setParameters(0, NO_PARAMETER);
+  Condition byAge = accounts.makeCondition("age", BETWEEN, "0", "0");
+  byAge.setParameters(1, 2);
+  Condition prepared(LOGICAL_AND, { byAge, byOwner });
+  Vector< Vector< std::string > > bindings;
+  bindings.pushBack({ "o8", "10", "20" });
+  bindings.pushBack({ "o9", "0", "89" });
+  bindings.pushBack({ "o100", "85", "85" });
+  for (size_t i = 0; i < bindings.size(); ++i)
+  {
+    prepared.bind(bindings[i]);
+    if (!prepared.isPlanned())
+    {
+      prepared = accounts.planCondition(prepared);
+    }
+    Condition expected(LOGICAL_AND, { accounts.makeCondition("owner", EQUAL, bindings[i][0]),
+      accounts.makeCondition("age", BETWEEN, bindings[i][1], bindings[i][2]) });
+    std::cout << prepared.getOperands()[0].getColumnIndex() << ' ';
+    std::cout << accounts.planCondition(prepared).isPlanned() << ' ';
+    std::cout << accounts.count(prepared) << ' ' << accounts.count(expected) << '\n';
+  }
+  try
+  {
+    prepared.bind({ "o8", "x", "1" });
+  }
+  catch (const std::invalid_argument&)
+  {
+    std::cout << "Invalid argument\n";
+  }
+
+  std::cout << "\n-------- EXPLAIN TEST: --------\n\n";
+
+  Vector< Condition > explained;
+  explained.pushBack(accounts.makeCondition("id", EQUAL, "8"));
+  explained.pushBack(accounts.makeCondition("owner", EQUAL, "o8"));
+  explained.pushBack(accounts.makeCondition("age", GREATER, "85"));
+  explained.pushBack(Condition(LOGICAL_OR, { explained[1], accounts.makeCondition("age", LESS, "2") }));
+  explained.pushBack(Condition(LOGICAL_AND, { accounts.makeCondition("balance", LESS, "100"), explained[1] }));
+  explained.pushBack(accounts.makeCondition("balance", LESS, "100"));
+  for (size_t i = 0; i < explained.size(); ++i)
+  {
+    Table::AccessPath path = accounts.explain(explained[i]);
+    bool isEstimated = (path.estimatedRows > 0.0) && (path.estimatedRows <= accounts.size());
+    std::cout << path.method << ' ' << path.columnIndex << ' ' << isEstimated << '\n';
+  }
+
+  std::cout << "\n-------- ID DIRECTORY TEST: --------\n\n";
+
+  std::istringstream sparseText("2 COLUMNS: id:PK name:TEXT\n[ 3 \"a\" ]\n[ 9000000000 \"b\" ]\n[ 20000 \"c\" ]\n");
+  Table sparse;
+  sparseText >> sparse;
+  sparse.insert({ "d" });
+  std::cout << sparse.update(9000000000, "name", "bb") << sparse.update(20000, "name", "cc");
+  std::cout << sparse.update(4, "name", "x") << '\n';
+  sparse.del(sparse.makeCondition("id", EQUAL, "3"));
+  sparse.printRows(std::cout);
+  std::cout << '\n';
+  printRows(sparse.select("id", "9000000001"));
+  std::cout << sparse.count(sparse.makeCondition("id", EQUAL, "3")) << '\n';
+  Table dense({ { "value", INTEGER } });
+  for (size_t i = 0; i < 20000; ++i)
+  {
+    dense.insert({ std::to_string(i) });
+  }
+  dense.del(dense.makeCondition("value", LESS, "10000"));
+  size_t nFound = 0;
+  for (size_t id = 0; id <= 20001; ++id)
+  {
+    nFound += dense.count(dense.makeCondition("id", EQUAL, std::to_string(id)));
+  }
+  std::cout << nFound << ' ' << dense.size() << '\n';
+
+  std::cout << "\n-------- DICTIONARY ENCODING TEST: --------\n\n";
+
+  Table shipments({ { "status", TEXT }, { "amount", INTEGER } });
+  const char* statuses[] = { "new", "paid", "sent" };
+  for (size_t i = 0; i < 300; ++i)
+  {
+    shipments.insert({ statuses[i % 3], std::to_string(i) });
+  }
+  {
+    std::ofstream file("table_load_test.txt");
+    file << shipments;
+  }
+  Table encoded = loadTable("table_load_test.txt");
+  std::cout << encoded.getColumnData(1).isEncoded() << encoded.getColumnData(2).isEncoded() << ' ';
+  std::cout << encoded.count(encoded.makeCondition("status", EQUAL, "paid")) << ' ';
+  std::cout << encoded.count(encoded.makeCondition("status", EQUAL, "lost")) << ' ';
+  std::cout << encoded.count(encoded.makeCondition("status", GREATER, "new")) << '\n';
+  encoded.update(encoded.makeCondition("amount", LESS, "3"), "status", "lost");
+  encoded.insert({ "lost", "300" });
+  printRows(encoded.select(encoded.makeCondition("status", EQUAL, "lost")));
+  encoded.del(encoded.makeCondition("amount", LESS, "200"));
+  std::cout << encoded.getColumnData(1).isEncoded() << ' ';
+  std::cout << encoded.count(encoded.makeCondition("status", EQUAL, "sent")) << '\n';
+  std::ostringstream encodedSnapshot;
+  encoded.writeSnapshot(encodedSnapshot);
+  Table decoded;
+  decoded.readSnapshot(encodedSnapshot.str().data(), encodedSnapshot.str().size());
+  std::cout << decoded.getColumnData(1).isEncoded() << decoded.encodeTexts() << ' ';
+  std::cout << decoded.count(decoded.makeCondition("status", EQUAL, "sent")) << '\n';
+  for (size_t i = 0; i < 200; ++i)
+  {
+    decoded.insert({ "s" + std::to_string(i), "0" });
+  }
+  std::cout << decoded.getColumnData(1).isEncoded() << ' ';
+  std::cout << decoded.count(decoded.makeCondition("status", EQUAL, "s150")) << ' ' << decoded.size() << '\n';
+  Table variants({ { "variant", TEXT }, { "amount", INTEGER } });
+  for (size_t i = 0; i < 1000; ++i)
+  {
+    variants.insert({ "v" + std::to_string(i % 100), std::to_string(i) });
+  }
+  std::cout << variants.encodeTexts() << ' ';
+  variants.del(variants.makeCondition("amount", LESS, "600"));
+  std::cout << variants.getColumnData(1).isEncoded() << ' ' << variants.size() << ' ';
+  std::cout << variants.count(variants.makeCondition("variant", EQUAL, "v42")) << '\n';
+  for (size_t i = 0; i < 300; ++i)
+  {
+    variants.update(1000, "variant", "x" + std::to_string(i));
+  }
+  std::cout << variants.getColumnData(1).isEncoded() << ' ';
+  std::cout << variants.count(variants.makeCondition("variant", EQUAL, "x299")) << ' ';
+  std::cout << variants.count(variants.makeCondition("variant", EQUAL, "x5")) << ' ';
+  std::cout << variants.count(variants.makeCondition("variant", EQUAL, "v99")) << '\n';
+
+  std::cout << "\n-------- VALUE PARSING TEST: --------\n\n";
+
+  Vector< std::string > tokens({ "42", "+7", "-3", "4x", "", "+-1", "3000000000", "1e400", "2.5e3", "inf" });
+  for (size_t i = 0; i < tokens.size(); ++i)
+  {
+    std::cout << checkValue(tokens[i], PK) << checkValue(tokens[i], INTEGER) << checkValue(tokens[i], REAL) << ' ';
+  }
+  std::cout << '\n';
+  long long integer = 0;
+  double real = 0.0;
+  std::cout << parseInteger("+7", INTEGER, integer) << ' ' << integer << ' ';
+  std::cout << parseInteger("3000000000", PK, integer) << ' ' << integer << ' ';
+  std::cout << parseReal("2.5e3", real) << ' ' << real << '\n';
+  std::cout << checkValue("9223372036854775807", PK) << checkValue("9223372036854775808", PK);
+  std::cout << checkValue("18446744073709551615", PK) << '\n';
+  Table parsed({ { "amount", INTEGER }, { "price", REAL } });
+  Vector< Table::Row > rows({ { "1", "1.5" }, { "4x", "1" }, { "3000000000", "1" }, { "2", "1e400" },
+    { "+3", "+2" } });
+  for (size_t i = 0; i < rows.size(); ++i)
+  {
+    std::cout << parsed.isCorrectRow(rows[i]);
+    if (parsed.isCorrectRow(rows[i]))
+    {
+      parsed.insert(rows[i]);
+    }
+  }
+  std::cout << '\n';
+  parsed.printRows(std::cout);
+  std::cout << '\n' << parsed.update(1, "amount", "-5") << '\n';
+  try
+  {
+    parsed.update(1, "amount", "3000000000");
+  }
+  catch (const std::invalid_argument& e)
+  {
+    std::cerr << e.what() << '\n';
+  }
+  Condition bound = parsed.makeCondition("amount", EQUAL, "0");
+  bound.setParameters(0, NO_PARAMETER);
+  try
+  {
+    bound.bind({ "5x" });
+  }
+  catch (const std::invalid_argument& e)
+  {
+    std::cerr << e.what() << '\n';
+  }
+  bound.bind({ "3" });
+  std::cout << parsed.count(bound) << '\n';
+
+  std::cout << "\n-------- SAVE AND REPLAY TEST: --------\n\n";
+
+  Table saved({ { "a", INTEGER } });
+  uint64_t savedFingerprint = saveTable(saved, "table_load_test.txt", false);
+  std::unique_ptr< WriteAheadLog > savedLog = resetLog("table_log_test.wal", saved.getLastId(), savedFingerprint);
+  for (size_t i = 1; i <= 3; ++i)
+  {
+    saved.insert({ std::to_string(i) });
+    savedLog->logInsert({ std::to_string(i) });
+  }
+  Condition lastRow = saved.makeCondition("id", EQUAL, "3");
+  saved.del(lastRow);
+  savedLog->logDelete(lastRow);
+  savedFingerprint = saveTable(saved, "table_load_test.txt", false);
+  savedLog = resetLog("table_log_test.wal", saved.getLastId(), savedFingerprint);
+  saved.insert({ "4" });
+  savedLog->logInsert({ "4" });
+  std::cout << saved.update(4, "a", "99") << ' ';
+  savedLog->logUpdate(4, "a", "99");
+  savedLog.reset();
+  Table reloaded = loadTable("table_load_test.txt");
+  savedFingerprint = getFileFingerprint("table_load_test.txt");
+  std::cout << reloaded.getLastId() << ' ' << replayLog("table_log_test.wal", reloaded, savedFingerprint) << ' ';
+  std::cout << reloaded.getLastId() << '\n';
+  reloaded.printRows(std::cout);
+  std::cout << '\n';
+  saveTable(reloaded, "table_load_test.txt", false);
+  Table crashed = loadTable("table_load_test.txt");
+  std::cout << replayLog("table_log_test.wal", crashed, getFileFingerprint("table_load_test.txt")) << ' ';
+  std::cout << crashed.size() << ' ' << replayLog("table_log_test.wal", crashed, 0) << '\n';
+  try
+  {
+    saveTable(reloaded, "missing_directory/table.txt", false);
+  }
+  catch (const std::runtime_error& e)
+  {
+    std::cerr << e.what() << '\n';
+  }
+
+  std::cout << "\n-------- UNORDERED CURSOR TEST: --------\n\n";
+
+  std::istringstream unorderedText("2 COLUMNS: id:PK a:INTEGER\n[ 5 1 ]\n[ 2 2 ]\n[ 9 3 ]\n[ 4 4 ]\n[ 7 5 ]\n");
+  Table unordered;
+  unorderedText >> unordered;
+  unordered.del(unordered.makeCondition("id", EQUAL, "9"));
+  unordered.del(unordered.makeCondition("id", EQUAL, "2"));
+  for (size_t cursor: { 9, 2, 3, 8 })
+  {
+    unordered.forEachAfter(cursor, [&](const Table::RowRef& row)
+    {
+      std::cout << row.getId() << ' ';
+      return true;
+    });
+    std::cout << '\n';
+  }
+
+  std::cout << "\n-------- INDEX ERASE TEST: --------\n\n";
+
+  Table flags({ { "flag", TEXT }, { "level", INTEGER } });
+  flags.createIndex("flag");
+  flags.createIndex("level", ORDERED_INDEX);
+  for (size_t i = 0; i < 200000; ++i)
+  {
+    flags.insert({ (i % 2) ? "on" : "off", std::to_string(i % 2) });
+  }
+  std::cout << flags.del(flags.makeCondition("flag", EQUAL, "on")) << ' ';
+  std::cout << flags.count(flags.makeCondition("flag", EQUAL, "on")) << ' ';
+  std::cout << flags.count(flags.makeCondition("flag", EQUAL, "off")) << ' ';
+  std::cout << flags.update(flags.makeCondition("flag", EQUAL, "off"), "flag", "on") << ' ';
+  std::cout << flags.count(flags.makeCondition("flag", EQUAL, "on")) << ' ';
+  std::cout << flags.update(flags.makeCondition("level", EQUAL, "0"), "level", "1") << ' ';
+  std::cout << flags.count(flags.makeCondition("level", LESS_EQUAL, "0")) << ' ';
+  std::cout << flags.count(flags.makeCondition("level", GREATER, "0")) << '\n';
+
+  std::cout << "\n-------- SNAPSHOT IDS TEST: --------\n\n";
+
+  Table pair({ { "value", INTEGER } });
+  pair.insert({ "10" });
+  pair.insert({ "20" });
+  std::ostringstream pairSnapshot;
+  pair.writeSnapshot(pairSnapshot);
+  std::string original = pairSnapshot.str();
+  long long ids[2] = { 1, 2 };
+  size_t idsPos = original.find(std::string(reinterpret_cast< const char* >(ids), sizeof(ids)));
+  for (long long second: { 1LL, 5LL, 2LL })
+  {
+    std::string patched = original;
+    std::memcpy(&patched[idsPos + sizeof(long long)], &second, sizeof(long long));
+    uint64_t blockChecksum = checksum(patched.data() + idsPos, sizeof(ids));
+    std::memcpy(&patched[idsPos + sizeof(ids)], &blockChecksum, sizeof(blockChecksum));
+    Table patchedTable;
+    try
+    {
+      patchedTable.readSnapshot(patched.data(), patched.size());
+      std::cout << patchedTable.size() << ' ' << patchedTable.getLastId() << '\n';
+    }
+    catch (const std::invalid_argument& e)
+    {
+      std::cout << e.what() << '\n';
+    }
+  }
 }
@@ -3,6 +3,8 @@
 
 void testVector();
 void testHashTable();
+void testOpenHashTable();
+void testBPlusTree();
 void testList();
 void testTable();
 void testHashTableTime();
@@ -62,4 +62,20 @@ void testVector()
 
   vect3 = std::move(vect2);
   print(vect3);
+
+  std::cout << "-------- RESERVE AND EMPLACE TEST: --------\n\n";
+
+  Vector< std::string > vect4;
+  vect4.reserve(10);
+  print(vect4);
+  vect4.emplaceBack(3, 'x');
+  vect4.emplaceBack("yy");
+  std::string moved = "moved";
+  vect4.pushBack(std::move(moved));
+  print(vect4);
+  vect4.shrinkToFit();
+  print(vect4);
+  vect4.pushBack(vect4[0]);
+  print(vect4);
+  std::cout << *vect4.data() << '\n';
 }